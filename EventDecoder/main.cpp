@@ -0,0 +1,128 @@
+#define _CRT_SECURE_NO_WARNINGS // fopen (SDL checks turn its deprecation warning into an error)
+#include <stdio.h>
+#include <string.h>
+#include <string>
+
+#include "Telemetry.h"
+
+using namespace std;
+
+/**
+ * Event decoder - prints a binary telemetry file (headless_sim events=<file>) as text
+ * Usage: event_decoder <file> [csv|summary]
+ *   default: one line per event
+ *   csv:     frame,unit,team,kind,a,b,c,d rows for spreadsheets and scripts
+ *   summary: event counts per kind only
+ */
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "Usage: event_decoder <file> [csv|summary]\n");
+        return 1;
+    }
+
+    string mode = (argc > 2) ? argv[2] : "text";
+    bool csv = (mode == "csv");
+    bool summaryOnly = (mode == "summary");
+
+    FILE* file = fopen(argv[1], "rb");
+    if (file == nullptr)
+    {
+        fprintf(stderr, "Cannot open %s\n", argv[1]);
+        return 1;
+    }
+
+    TelemetryHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1 || memcmp(header.magic, TELEMETRY_MAGIC, 4) != 0)
+    {
+        fprintf(stderr, "%s is not a telemetry file\n", argv[1]);
+        fclose(file);
+        return 1;
+    }
+
+    if (header.version != TELEMETRY_VERSION || header.recordSize != sizeof(TelemetryEvent))
+    {
+        fprintf(stderr, "Unsupported telemetry version %u (record size %u)\n", header.version, header.recordSize);
+        fclose(file);
+        return 1;
+    }
+
+    if (csv)
+        printf("frame,unit,team,kind,a,b,c,d\n");
+
+    long long counts[EVENT_KIND_COUNT] = { 0 };
+    long long total = 0;
+    int matches = 0;
+
+    const size_t BLOCK_EVENTS = 4096;
+    TelemetryEvent block[BLOCK_EVENTS];
+    size_t read;
+
+    while ((read = fread(block, sizeof(TelemetryEvent), BLOCK_EVENTS, file)) > 0)
+    {
+        for (size_t i = 0; i < read; i++)
+        {
+            const TelemetryEvent& e = block[i];
+            total++;
+            if (e.kind < EVENT_KIND_COUNT)
+                counts[e.kind]++;
+            if (e.kind == EVENT_MATCH_START)
+                matches++;
+
+            if (summaryOnly)
+                continue;
+
+            if (csv)
+            {
+                printf("%u,%d,%d,%s,%d,%d,%d,%d\n", e.frame, e.unit, e.team, EventKindName(e.kind),
+                    e.a, e.b, e.c, e.d);
+                continue;
+            }
+
+            printf("%7u  ", e.frame);
+            switch (e.kind)
+            {
+            case EVENT_MATCH_START:
+                printf("match %d start, %d units\n", matches, e.a);
+                break;
+            case EVENT_MATCH_END:
+                printf("match end, winner team %d\n", e.a);
+                break;
+            case EVENT_SHOT:
+            case EVENT_GRENADE:
+                printf("unit %d (team %d) %s -> unit %d at (%d,%d) for %d\n", e.unit, e.team,
+                    EventKindName(e.kind), e.a, e.c, e.d, e.b);
+                break;
+            case EVENT_DAMAGE:
+                printf("unit %d (team %d) takes %d damage, %d HP left\n", e.unit, e.team, e.a, e.b);
+                break;
+            case EVENT_DEATH:
+                printf("unit %d (team %d) dies at (%d,%d)\n", e.unit, e.team, e.a, e.b);
+                break;
+            case EVENT_HEAL:
+                printf("unit %d (team %d) heals unit %d to %d HP\n", e.unit, e.team, e.a, e.b);
+                break;
+            case EVENT_RESUPPLY:
+                printf("unit %d (team %d) resupplies unit %d: ammo %d, grenades %d\n", e.unit, e.team,
+                    e.a, e.b, e.c);
+                break;
+            default:
+                printf("unknown event kind %d\n", e.kind);
+                break;
+            }
+        }
+    }
+
+    fclose(file);
+
+    if (!csv)
+    {
+        printf("==================================\n");
+        printf("Matches: %d  Events: %lld\n", matches, total);
+        for (int kind = 0; kind < EVENT_KIND_COUNT; kind++)
+            printf("  %-12s %lld\n", EventKindName(kind), counts[kind]);
+    }
+
+    return 0;
+}
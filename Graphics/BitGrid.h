@@ -0,0 +1,168 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BITGRID_SSE2 1
+#endif
+
+/**
+ * BitGrid class - One bit per map cell, stored as rows of 64-bit words
+ * Used for visibility maps: a 30x30 map is 30 words instead of 900 bools, a cell test is one shift,
+ * and merging two grids is a word-wide (SSE2 when available) OR over contiguous memory
+ */
+class BitGrid
+{
+private:
+    int rows, cols;
+    int wordsPerRow;
+    std::vector<uint64_t> words; // Row-major, wordsPerRow words per row
+
+public:
+    /**
+     * Constructor - all cells cleared
+     */
+    BitGrid(int numRows = 0, int numCols = 0);
+
+    /**
+     * Change dimensions, all cells cleared
+     */
+    void resize(int numRows, int numCols);
+
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+    int getWordsPerRow() const { return wordsPerRow; }
+    int getWordCount() const { return (int)words.size(); }
+    const uint64_t* data() const { return words.data(); }
+
+    /**
+     * Check a cell (no bounds check)
+     */
+    bool get(int r, int c) const { return (words[r * wordsPerRow + (c >> 6)] >> (c & 63)) & 1; }
+
+    /**
+     * Set a cell (no bounds check)
+     */
+    void set(int r, int c) { words[r * wordsPerRow + (c >> 6)] |= (uint64_t)1 << (c & 63); }
+
+    /**
+     * Clear every cell
+     */
+    void clear() { std::fill(words.begin(), words.end(), 0); }
+
+    /**
+     * Clear count rows starting at firstRow (clipped to the grid)
+     */
+    void clearRows(int firstRow, int count);
+
+    /**
+     * Add every cell set in other (same dimensions) within count rows starting at firstRow
+     * (clipped to the grid) to this grid
+     */
+    void orRows(const BitGrid& other, int firstRow, int count);
+
+    /**
+     * Add a smaller grid (given as its words) whose cell (0, 0) lies at (top, left) here -
+     * parts outside this grid are dropped. dims are this grid's dimensions (see GridDims.h)
+     */
+    template <typename Dims>
+    void orWindow(const Dims& dims, const uint64_t* windowWords, int windowRows, int windowCols, int top, int left);
+};
+
+// Implementation:
+inline BitGrid::BitGrid(int numRows, int numCols)
+{
+    resize(numRows, numCols);
+}
+
+inline void BitGrid::resize(int numRows, int numCols)
+{
+    rows = numRows;
+    cols = numCols;
+    wordsPerRow = (numCols + 63) / 64;
+    words.assign((size_t)rows * wordsPerRow, 0);
+}
+
+inline void BitGrid::clearRows(int firstRow, int count)
+{
+    int first = std::max(0, firstRow);
+    int last = std::min(rows, firstRow + count);
+    if (first < last)
+        std::fill(words.begin() + (size_t)first * wordsPerRow, words.begin() + (size_t)last * wordsPerRow, 0);
+}
+
+inline void BitGrid::orRows(const BitGrid& other, int firstRow, int count)
+{
+    int first = std::max(0, firstRow);
+    int last = std::min(rows, firstRow + count);
+    if (first >= last)
+        return;
+
+    // The rows are contiguous, so the range is one run of words
+    uint64_t* dst = words.data() + (size_t)first * wordsPerRow;
+    const uint64_t* src = other.words.data() + (size_t)first * wordsPerRow;
+    size_t wordCount = (size_t)(last - first) * wordsPerRow;
+    size_t i = 0;
+
+#ifdef BITGRID_SSE2
+    for (; i + 2 <= wordCount; i += 2)
+    {
+        __m128i a = _mm_loadu_si128((const __m128i*)(dst + i));
+        __m128i b = _mm_loadu_si128((const __m128i*)(src + i));
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_or_si128(a, b));
+    }
+#endif
+
+    for (; i < wordCount; i++)
+        dst[i] |= src[i];
+}
+
+template <typename Dims>
+inline void BitGrid::orWindow(const Dims& dims, const uint64_t* windowWords, int windowRows, int windowCols, int top, int left)
+{
+    // Shadow the members - with fixed dims these become compile-time constants
+    const int rows = dims.getRows();
+    const int cols = dims.getCols();
+    const int wordsPerRow = dims.getBitWordsPerRow();
+    int windowWordsPerRow = (windowCols + 63) / 64;
+
+    for (int wr = 0; wr < windowRows; wr++)
+    {
+        int r = top + wr;
+        if (r < 0 || r >= rows)
+            continue;
+
+        uint64_t* dst = &words[(size_t)r * wordsPerRow];
+        const uint64_t* src = &windowWords[(size_t)wr * windowWordsPerRow];
+
+        for (int ww = 0; ww < windowWordsPerRow; ww++)
+        {
+            uint64_t bits = src[ww];
+            if (bits == 0)
+                continue;
+
+            // Column of bit 0 of this window word in this grid
+            int col = left + ww * 64;
+            if (col < 0)
+            {
+                if (col <= -64)
+                    continue;
+                bits >>= -col;
+                col = 0;
+            }
+            if (col >= cols)
+                continue;
+
+            int word = col >> 6;
+            int shift = col & 63;
+            dst[word] |= bits << shift;
+            if (shift != 0 && word + 1 < wordsPerRow)
+                dst[word + 1] |= bits >> (64 - shift);
+        }
+
+        // Bits shifted past the last column would land in row padding - clear it
+        if (cols & 63)
+            dst[wordsPerRow - 1] &= ((uint64_t)1 << (cols & 63)) - 1;
+    }
+}
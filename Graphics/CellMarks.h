@@ -0,0 +1,51 @@
+#pragma once
+#include <vector>
+
+/**
+ * CellMarks class - Generation-stamped set of map cells
+ * Used as the A* closed set and the BFS visited set. A cell is in the set when its stamp
+ * equals the current generation, so clearing the whole set is a single counter increment
+ */
+class CellMarks
+{
+private:
+    std::vector<unsigned int> stamps; // Cell index -> generation it was last marked in
+    unsigned int generation;
+
+public:
+    CellMarks() : generation(0) {}
+
+    /**
+     * Start a new empty set covering numCells cells - O(1) unless the map size changed
+     */
+    void reset(int numCells);
+
+    /**
+     * Check if cell is in the set
+     */
+    bool contains(int cell) const { return stamps[cell] == generation; }
+
+    /**
+     * Add cell to the set
+     */
+    void mark(int cell) { stamps[cell] = generation; }
+};
+
+// Implementation:
+inline void CellMarks::reset(int numCells)
+{
+    if ((int)stamps.size() != numCells)
+    {
+        stamps.assign(numCells, 0);
+        generation = 0;
+    }
+
+    generation++;
+
+    // Counter wrapped around - old stamps could match again, so clear them for real
+    if (generation == 0)
+    {
+        stamps.assign(numCells, 0);
+        generation = 1;
+    }
+}
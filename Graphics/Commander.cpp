@@ -2,7 +2,34 @@
 #include "Warrior.h"
 #include "Medic.h"
 #include "Supply.h"
-#include <iostream>
+#include "TeamRoster.h"
+#include "Log.h"
+
+namespace
+{
+    thread_local BitGrid standaloneVisibility; // Built on demand for commanders without a match
+
+    template <typename T>
+    void OrVisibility(const std::vector<T*>& units, BitGrid& target)
+    {
+        for (auto unit : units)
+            unit->orVisibilityInto(target);
+    }
+
+    /**
+     * First of units standing on a cell set in visibility, null if none is
+     */
+    template <typename T>
+    Unit* FindVisible(const std::vector<T*>& units, const BitGrid& visibility)
+    {
+        for (auto unit : units)
+        {
+            if (visibility.get(unit->getRow(), unit->getCol()))
+                return unit;
+        }
+        return nullptr;
+    }
+}
 
 Commander::Commander(int startRow, int startCol, int teamId)
     : Unit(startRow, startCol, teamId, COMMANDER, 'C')
@@ -11,15 +38,11 @@ Commander::Commander(int startRow, int startCol, int teamId)
     enemySeen = false;
     lastSeenEnemyRow = -1;
     lastSeenEnemyCol = -1;
-
-    for (int i = 0; i < MAP_SIZE; i++)
-        for (int j = 0; j < MAP_SIZE; j++)
-            teamVisibilityMap[i][j] = false;
 }
 
 void Commander::update(
-    int map[][MAP_SIZE],
-    int safetyMap[][MAP_SIZE],
+    const Grid<int>& map,
+    const Grid<int>& safetyMap,
     std::vector<Unit*>& allUnits)
 {
     if (!alive)
@@ -35,7 +58,7 @@ void Commander::update(
 
     detectRepeatingPattern(map, allUnits);
 
-    checkTreeHidingLimit(map, allUnits);
+    checkTreeHidingLimit(map);
 
     if (escapingTree)
     {
@@ -50,7 +73,7 @@ void Commander::update(
                 int newRow = row + (deltaRow > 0 ? 1 : -1);
                 if (isPositionAvailable(map, newRow, col, allUnits) && map[newRow][col] != TREE)
                 {
-                    row = newRow;
+                    setPosition(newRow, col);
                     return;
                 }
             }
@@ -59,7 +82,7 @@ void Commander::update(
                 int newCol = col + (deltaCol > 0 ? 1 : -1);
                 if (isPositionAvailable(map, row, newCol, allUnits) && map[row][newCol] != TREE)
                 {
-                    col = newCol;
+                    setPosition(row, newCol);
                     return;
                 }
             }
@@ -75,8 +98,7 @@ void Commander::update(
 
             if (isPositionAvailable(map, newRow, newCol, allUnits) && map[newRow][newCol] != TREE)
             {
-                row = newRow;
-                col = newCol;
+                setPosition(newRow, newCol);
                 break;
             }
         }
@@ -96,7 +118,7 @@ void Commander::update(
                 int newRow = row + (deltaRow > 0 ? 1 : -1);
                 if (isPositionAvailable(map, newRow, col, allUnits))
                 {
-                    row = newRow;
+                    setPosition(newRow, col);
                     return;
                 }
             }
@@ -105,7 +127,7 @@ void Commander::update(
                 int newCol = col + (deltaCol > 0 ? 1 : -1);
                 if (isPositionAvailable(map, row, newCol, allUnits))
                 {
-                    col = newCol;
+                    setPosition(row, newCol);
                     return;
                 }
             }
@@ -113,7 +135,7 @@ void Commander::update(
         else
         {
             int bestRow = row, bestCol = col;
-            int minDanger = (safetyMap != nullptr) ? safetyMap[row][col] : 999;
+            int minDanger = safetyMap[row][col];
 
             int deltaRow[] = { 0, -1, 1, 0 };
             int deltaCol[] = { 1, 0, 0, -1 };
@@ -125,7 +147,7 @@ void Commander::update(
 
                 if (isPositionAvailable(map, newRow, newCol, allUnits))
                 {
-                    int danger = (safetyMap != nullptr) ? safetyMap[newRow][newCol] : 0;
+                    int danger = safetyMap[newRow][newCol];
                     if (danger < minDanger)
                     {
                         minDanger = danger;
@@ -137,83 +159,84 @@ void Commander::update(
 
             if (bestRow != row || bestCol != col)
             {
-                row = bestRow;
-                col = bestCol;
+                setPosition(bestRow, bestCol);
             }
         }
         return;
     }
 
-    buildTeamVisibilityMap(allUnits);
-
     enemySeen = isEnemyVisible(allUnits);
 
-    giveOrders(map, safetyMap, allUnits);
+    giveOrders(allUnits);
 
     findSafePosition(map, safetyMap, allUnits);
 }
 
-void Commander::buildTeamVisibilityMap(std::vector<Unit*>& allUnits)
+bool Commander::isEnemyVisible(std::vector<Unit*>& allUnits)
 {
-    for (int i = 0; i < MAP_SIZE; i++)
-        for (int j = 0; j < MAP_SIZE; j++)
-            teamVisibilityMap[i][j] = false;
-
-    for (auto unit : allUnits)
+    // The match merges every team's visibility once per frame - without one, merge it here
+    const BitGrid* teamVisibility;
+    if (context != nullptr && context->teamVisibility != nullptr)
     {
-        if (unit->getTeam() == team && unit->isAlive())
-        {
-            for (int i = 0; i < MAP_SIZE; i++)
-            {
-                for (int j = 0; j < MAP_SIZE; j++)
-                {
-                    if (unit->getVisibility(i, j))
-                        teamVisibilityMap[i][j] = true;
-                }
-            }
-        }
+        teamVisibility = &context->teamVisibility[team];
     }
-}
-
-bool Commander::isEnemyVisible(std::vector<Unit*>& allUnits)
-{
-    bool seen = false;
-
-    for (auto unit : allUnits)
+    else
     {
-        if (unit->getTeam() != team && unit->isAlive())
-        {
-            int r = unit->getRow();
-            int c = unit->getCol();
-
-            if (teamVisibilityMap[r][c])
-            {
-                lastSeenEnemyRow = r;
-                lastSeenEnemyCol = c;
-                seen = true;
-            }
-        }
+        if (standaloneVisibility.getRows() != visibilityMap.getRows() || standaloneVisibility.getCols() != visibilityMap.getCols())
+            standaloneVisibility.resize(visibilityMap.getRows(), visibilityMap.getCols());
+        else
+            standaloneVisibility.clear();
+
+        const TeamRoster& roster = getTeamRoster(allUnits);
+        orVisibilityInto(standaloneVisibility);
+        OrVisibility(roster.getWarriors(), standaloneVisibility);
+        OrVisibility(roster.getMedics(), standaloneVisibility);
+        OrVisibility(roster.getSupplies(), standaloneVisibility);
+        teamVisibility = &standaloneVisibility;
     }
 
-    return seen;
+    // Only the alive enemies are tested, and the first one seen is enough
+    const TeamRoster& enemies = getRoster(team == TEAM_BLUE ? TEAM_ORANGE : TEAM_BLUE, allUnits);
+    Unit* seen = enemies.getCommander();
+    if (seen != nullptr && !teamVisibility->get(seen->getRow(), seen->getCol()))
+        seen = nullptr;
+    if (seen == nullptr)
+        seen = FindVisible(enemies.getWarriors(), *teamVisibility);
+    if (seen == nullptr)
+        seen = FindVisible(enemies.getMedics(), *teamVisibility);
+    if (seen == nullptr)
+        seen = FindVisible(enemies.getSupplies(), *teamVisibility);
+
+    if (seen == nullptr)
+        return false;
+
+    lastSeenEnemyRow = seen->getRow();
+    lastSeenEnemyCol = seen->getCol();
+    return true;
 }
 
-void Commander::giveOrders(
-    int map[][MAP_SIZE],
-    int safetyMap[][MAP_SIZE],
-    std::vector<Unit*>& allUnits)
+void Commander::giveOrders(std::vector<Unit*>& allUnits)
 {
-    int aliveWarriors = 0;
-    int totalTeamMembers = 0;
-
-    for (auto unit : allUnits)
+    // The roster hands out the team by role - only free support units need picking out
+    const TeamRoster& roster = getTeamRoster(allUnits);
+    const std::vector<Warrior*>& warriors = roster.getWarriors();
+    int aliveWarriors = (int)warriors.size();
+    int totalTeamMembers = roster.size();
+
+    std::vector<Medic*>& freeMedics = orderMedics;
+    std::vector<Supply*>& freeSupplies = orderSupplies;
+    freeMedics.clear();
+    freeSupplies.clear();
+
+    for (auto medic : roster.getMedics())
     {
-        if (unit->getTeam() == team && unit->isAlive())
-        {
-            totalTeamMembers++;
-            if (unit->getUnitType() == WARRIOR)
-                aliveWarriors++;
-        }
+        if (!medic->hasActiveOrder())
+            freeMedics.push_back(medic);
+    }
+    for (auto supply : roster.getSupplies())
+    {
+        if (!supply->hasActiveOrder())
+            freeSupplies.push_back(supply);
     }
 
     if (totalTeamMembers <= 2 || !enemySeen)
@@ -225,59 +248,44 @@ void Commander::giveOrders(
         inDefenseMode = false;
     }
 
-    for (auto unit : allUnits)
+    // Each request goes to the first free support unit. A unit that refuses (out of charges)
+    // stays first in line, as it would when searching the unit list for every request
+    size_t nextMedic = 0;
+    size_t nextSupply = 0;
+
+    for (auto warrior : warriors)
     {
-        if (unit->getTeam() == team && unit->isAlive() && unit->getUnitType() == WARRIOR)
+        if (warrior->getNeedsMedic())
         {
-            Warrior* warrior = dynamic_cast<Warrior*>(unit);
-            if (warrior)
-            {
-                if (warrior->getNeedsMedic())
-                {
-                    std::cout << "Team " << team << " Commander: Warrior needs medic! Searching for available medic..." << std::endl;
-
-                    bool medicFound = false;
-                    for (auto u : allUnits)
-                    {
-                        if (u->getTeam() == team && u->isAlive() && u->getUnitType() == MEDIC)
-                        {
-                            Medic* medic = dynamic_cast<Medic*>(u);
-                            if (medic && !medic->hasActiveOrder())
-                            {
-                                medic->receiveOrder(warrior->getRow(), warrior->getCol());
-                                medicFound = true;
-                                break;
-                            }
-                        }
-                    }
+            LOG_DEBUG(LOG_SUPPORT, "Team " << team << " Commander: Warrior needs medic! Searching for available medic...");
 
-                    if (!medicFound)
-                    {
-                        std::cout << "Team " << team << " Commander: No available medic found (medic busy or out of charges)" << std::endl;
-                    }
-                }
+            if (nextMedic < freeMedics.size())
+            {
+                Medic* medic = freeMedics[nextMedic];
+                medic->receiveOrder(warrior->getRow(), warrior->getCol());
+                if (medic->hasActiveOrder())
+                    nextMedic++;
+            }
+            else
+            {
+                LOG_INFO(LOG_SUPPORT, "Team " << team << " Commander: No available medic found (medic busy or out of charges)");
+            }
+        }
 
-                if (warrior->getNeedsAmmo())
-                {
-                    for (auto u : allUnits)
-                    {
-                        if (u->getTeam() == team && u->isAlive() && u->getUnitType() == SUPPLY)
-                        {
-                            Supply* supply = dynamic_cast<Supply*>(u);
-                            if (supply && !supply->hasActiveOrder())
-                            {
-                                supply->receiveOrder(warrior->getRow(), warrior->getCol());
-                                break;
-                            }
-                        }
-                    }
-                }
+        if (warrior->getNeedsAmmo())
+        {
+            if (nextSupply < freeSupplies.size())
+            {
+                Supply* supply = freeSupplies[nextSupply];
+                supply->receiveOrder(warrior->getRow(), warrior->getCol());
+                if (supply->hasActiveOrder())
+                    nextSupply++;
             }
         }
     }
 }
 
-void Commander::findSafePosition(int map[][MAP_SIZE], int safetyMap[][MAP_SIZE], std::vector<Unit*>& allUnits)
+void Commander::findSafePosition(const Grid<int>& map, const Grid<int>& safetyMap, std::vector<Unit*>& allUnits)
 {
     int currentDanger = safetyMap[row][col];
 
@@ -307,8 +315,7 @@ void Commander::findSafePosition(int map[][MAP_SIZE], int safetyMap[][MAP_SIZE],
 
         if (bestRow != row || bestCol != col)
         {
-            row = bestRow;
-            col = bestCol;
+            setPosition(bestRow, bestCol);
         }
         else
         {
@@ -333,8 +340,7 @@ void Commander::findSafePosition(int map[][MAP_SIZE], int safetyMap[][MAP_SIZE],
                     int cell2 = map[newRow][newCol];
                     if (cell2 != AMMO_DEPOT && cell2 != MEDICAL_DEPOT)
                     {
-                        row = newRow;
-                        col = newCol;
+                        setPosition(newRow, newCol);
                         return;
                     }
                 }
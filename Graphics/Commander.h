@@ -1,6 +1,10 @@
 #pragma once
 #include "Unit.h"
 
+class Warrior;
+class Medic;
+class Supply;
+
 /**
  * Commander class - Plans team strategy and gives orders
  * Uses combined visibility map from all team members
@@ -8,11 +12,14 @@
 class Commander : public Unit
 {
 private:
-    bool teamVisibilityMap[MAP_SIZE][MAP_SIZE]; // Combined visibility of all team units
     bool inDefenseMode;
     int lastSeenEnemyRow, lastSeenEnemyCol;
     bool enemySeen;
 
+    // giveOrders working lists, kept between frames so they do not reallocate
+    std::vector<Medic*> orderMedics;   // Medics without an order
+    std::vector<Supply*> orderSupplies; // Supply units without an order
+
 public:
     /**
      * Constructor
@@ -23,16 +30,11 @@ public:
      * Update commander behavior
      */
     void update(
-        int map[][MAP_SIZE],
-        int safetyMap[][MAP_SIZE],
+        const Grid<int>& map,
+        const Grid<int>& safetyMap,
         std::vector<Unit*>& allUnits
     ) override;
 
-    /**
-     * Build combined visibility map from all team units
-     */
-    void buildTeamVisibilityMap(std::vector<Unit*>& allUnits);
-
     /**
      * Check if enemy is visible to team
      */
@@ -41,14 +43,10 @@ public:
     /**
      * Give orders to team members
      */
-    void giveOrders(
-        int map[][MAP_SIZE],
-        int safetyMap[][MAP_SIZE],
-        std::vector<Unit*>& allUnits
-    );
+    void giveOrders(std::vector<Unit*>& allUnits);
 
     /**
      * Find safe position for commander
      */
-    void findSafePosition(int map[][MAP_SIZE], int safetyMap[][MAP_SIZE], std::vector<Unit*>& allUnits);
+    void findSafePosition(const Grid<int>& map, const Grid<int>& safetyMap, std::vector<Unit*>& allUnits);
 };
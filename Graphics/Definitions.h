@@ -21,6 +21,7 @@ const int COMMANDER = 0;
 const int WARRIOR = 1;
 const int MEDIC = 2;
 const int SUPPLY = 3;
+const int ANY_UNIT_TYPE = -1; // Unit queries: match every type
 
 // Teams
 const int TEAM_BLUE = 0;
@@ -35,8 +36,12 @@ const int LEFT = 3;
 const int STAY = -1;
 
 // Game constants
-const int MAP_SIZE = 30;
-const int NUM_UNITS_PER_TEAM = 5; // Commander + 2 Warriors + Medic + Supply
+const int MAP_SIZE = 30;     // Default battlefield size (Simulation::setMapSize picks another)
+const int MIN_MAP_SIZE = 20; // Smallest battlefield that fits both team corners and the terrain margins
+const int DEFAULT_WARRIORS = 2;   // Default roster: Commander + 2 Warriors + Medic + Supply
+const int DEFAULT_MEDICS = 1;
+const int DEFAULT_SUPPLIES = 1;
+const int SPAWN_ZONE_SIZE = 8;   // Cleared team corner for the default roster (grows with larger rosters)
 
 // Combat parameters
 const int MAX_HEALTH = 100;
@@ -48,9 +53,16 @@ const int SHOOTING_RANGE = 8;
 const int GRENADE_RANGE = 6;
 const int VISIBILITY_RANGE = 15;
 
+// Visibility engines (LineOfSight::setEngine)
+const int FOV_BRESENHAM = 0;   // One Bresenham line per cell in range
+const int FOV_SHADOWCAST = 1;  // Symmetric shadowcasting - each cell in range scanned once per quadrant
+
 // AI parameters
 const int MAX_BFS_DEPTH = 20; // For finding cover
 const int DANGER_THRESHOLD = 30; // Safety map threshold
+const int DANGER_RADIUS = SHOOTING_RANGE + 2; // Cells around a visible enemy that get danger
+const int DANGER_STEP = 10;      // Danger lost per cell of distance from the enemy (100 at its cell)
+const int DANGER_LEVELS = 10;    // Distinct non-zero danger values: 10, 20, ..., 100
 
 // Unit stats
 const int MEDIC_HEAL_AMOUNT = 100;  // Heal to full health
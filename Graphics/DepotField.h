@@ -0,0 +1,75 @@
+#pragma once
+#include "Definitions.h"
+#include "Grid.h"
+#include <vector>
+
+/**
+ * DepotField class - Steps from every cell to one depot (a Dijkstra map with unit step costs)
+ * Depots and terrain never change during a match, so the field is built once by a breadth-first
+ * search out of the depot. A unit heading for the depot then just steps to a neighbour one step
+ * closer - no search per trip. Units do not block the field: a unit whose way is taken waits, as it
+ * would on an A* path
+ */
+class DepotField
+{
+private:
+    Grid<int> distance;  // Steps to the depot, -1 where it cannot be reached
+    int depotRow, depotCol;
+    std::vector<int> queue; // Search frontier, kept between builds
+
+public:
+    DepotField() : depotRow(-1), depotCol(-1) {}
+
+    /**
+     * Fill the field of the depot at (r, c) on map
+     */
+    void build(const Grid<int>& map, int r, int c);
+
+    int getDepotRow() const { return depotRow; }
+    int getDepotCol() const { return depotCol; }
+
+    /**
+     * Steps from (r, c) to the depot, -1 if it cannot be reached (or is off the map)
+     */
+    int get(int r, int c) const { return distance.inBounds(r, c) ? distance[r][c] : -1; }
+};
+
+// Implementation:
+inline void DepotField::build(const Grid<int>& map, int r, int c)
+{
+    const int rows = map.getRows();
+    const int cols = map.getCols();
+
+    depotRow = r;
+    depotCol = c;
+    distance.resize(rows, cols, -1);
+
+    queue.clear();
+    queue.push_back(r * cols + c);
+    distance[r][c] = 0;
+
+    int deltaRow[] = { 0, -1, 1, 0 };
+    int deltaCol[] = { 1, 0, 0, -1 };
+
+    for (size_t head = 0; head < queue.size(); head++)
+    {
+        int cellRow = queue[head] / cols;
+        int cellCol = queue[head] % cols;
+        int next = distance[cellRow][cellCol] + 1;
+
+        for (int dir = 0; dir < 4; dir++)
+        {
+            int nr = cellRow + deltaRow[dir];
+            int nc = cellCol + deltaCol[dir];
+            if (!map.inBounds(nr, nc) || distance[nr][nc] != -1)
+                continue;
+
+            // Same walkability as Unit::isValidMove
+            if (map[nr][nc] == ROCK || map[nr][nc] == WATER)
+                continue;
+
+            distance[nr][nc] = next;
+            queue.push_back(nr * cols + nc);
+        }
+    }
+}
@@ -0,0 +1,122 @@
+#pragma once
+#include <vector>
+#include <new>
+#include <cstddef>
+#include <cstdint>
+
+const int CACHE_LINE_SIZE = 64;
+
+/**
+ * Cells of type T that fit in one cache line (at least 1)
+ */
+template <typename T>
+constexpr int GridCellsPerLine()
+{
+    return (CACHE_LINE_SIZE / sizeof(T)) > 0 ? (int)(CACHE_LINE_SIZE / sizeof(T)) : 1;
+}
+
+/**
+ * Row stride of a Grid<T> with numCols columns: numCols rounded up to a whole cache line
+ */
+template <typename T>
+constexpr int GridStride(int numCols)
+{
+    return (numCols + GridCellsPerLine<T>() - 1) / GridCellsPerLine<T>() * GridCellsPerLine<T>();
+}
+
+/**
+ * CacheAlignedAllocator - Hands out memory that starts on a cache line boundary
+ */
+template <typename T>
+struct CacheAlignedAllocator
+{
+    typedef T value_type;
+
+    CacheAlignedAllocator() {}
+    template <typename U> CacheAlignedAllocator(const CacheAlignedAllocator<U>&) {}
+
+    T* allocate(size_t n)
+    {
+        // Over-allocate, align, and keep the original pointer just before the aligned block
+        char* raw = static_cast<char*>(::operator new(n * sizeof(T) + CACHE_LINE_SIZE + sizeof(void*)));
+        uintptr_t aligned = ((uintptr_t)(raw + sizeof(void*)) + CACHE_LINE_SIZE - 1) & ~(uintptr_t)(CACHE_LINE_SIZE - 1);
+        reinterpret_cast<void**>(aligned)[-1] = raw;
+        return reinterpret_cast<T*>(aligned);
+    }
+
+    void deallocate(T* p, size_t)
+    {
+        ::operator delete(reinterpret_cast<void**>(p)[-1]);
+    }
+
+    template <typename U> bool operator==(const CacheAlignedAllocator<U>&) const { return true; }
+    template <typename U> bool operator!=(const CacheAlignedAllocator<U>&) const { return false; }
+};
+
+/**
+ * Grid class - Two-dimensional array whose size is chosen at runtime
+ * Row-major flat storage; every row is padded to start on a cache line, so a row scan never
+ * straddles a line it does not need. grid[r][c] works like the old fixed-size arrays
+ */
+template <typename T>
+class Grid
+{
+private:
+    int rows, cols;
+    int stride; // Elements from the start of one row to the next (cols rounded up to a cache line)
+    std::vector<T, CacheAlignedAllocator<T>> cells;
+
+public:
+    Grid() : rows(0), cols(0), stride(0) {}
+
+    Grid(int numRows, int numCols, const T& value = T()) : rows(0), cols(0), stride(0)
+    {
+        resize(numRows, numCols, value);
+    }
+
+    /**
+     * Change dimensions, every cell set to value
+     */
+    void resize(int numRows, int numCols, const T& value = T());
+
+    /**
+     * Set every cell to value
+     */
+    void fill(const T& value);
+
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+    int getStride() const { return stride; }
+    int getCellCount() const { return rows * cols; }
+
+    bool inBounds(int r, int c) const { return r >= 0 && r < rows && c >= 0 && c < cols; }
+
+    /**
+     * First cell of row 0 - cell (r, c) is at data()[r * getStride() + c]
+     */
+    T* data() { return cells.data(); }
+    const T* data() const { return cells.data(); }
+
+    /**
+     * Pointer to the first cell of row r - grid[r][c] is cell (r, c)
+     */
+    T* operator[](int r) { return cells.data() + (size_t)r * stride; }
+    const T* operator[](int r) const { return cells.data() + (size_t)r * stride; }
+};
+
+// Implementation:
+template <typename T>
+inline void Grid<T>::resize(int numRows, int numCols, const T& value)
+{
+    rows = numRows;
+    cols = numCols;
+    stride = GridStride<T>(numCols);
+    cells.assign((size_t)rows * stride, value);
+}
+
+template <typename T>
+inline void Grid<T>::fill(const T& value)
+{
+    for (size_t i = 0; i < cells.size(); i++)
+        cells[i] = value;
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include "Definitions.h"
+#include "Grid.h"
+
+/**
+ * FixedGridDims - Map dimensions known at compile time
+ * Grid kernels are templates over a dims type. Instantiated with FixedGridDims, their loop bounds,
+ * row strides and cell indices are constants the compiler can fold, unroll and vectorize;
+ * with DynamicGridDims the same code runs for any map size. DispatchGridDims picks one per call
+ */
+template <int ROWS, int COLS>
+struct FixedGridDims
+{
+    int getRows() const { return ROWS; }
+    int getCols() const { return COLS; }
+    int getCellCount() const { return ROWS * COLS; }
+    int getBitWordsPerRow() const { return (COLS + 63) / 64; }
+
+    bool inBounds(int r, int c) const { return (unsigned)r < (unsigned)ROWS && (unsigned)c < (unsigned)COLS; }
+
+    /**
+     * Dense index of cell (r, c) - for per-cell search buffers
+     */
+    int cellIndex(int r, int c) const { return r * COLS + c; }
+
+    /**
+     * Cell (r, c) of a grid with these dimensions
+     */
+    template <typename T>
+    const T& at(const Grid<T>& grid, int r, int c) const { return grid.data()[r * GridStride<T>(COLS) + c]; }
+
+    template <typename T>
+    T& at(Grid<T>& grid, int r, int c) const { return grid.data()[r * GridStride<T>(COLS) + c]; }
+};
+
+/**
+ * DynamicGridDims - Map dimensions known only at runtime (the fallback for unlisted sizes)
+ */
+struct DynamicGridDims
+{
+    int rows, cols;
+
+    DynamicGridDims(int numRows, int numCols) : rows(numRows), cols(numCols) {}
+
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+    int getCellCount() const { return rows * cols; }
+    int getBitWordsPerRow() const { return (cols + 63) / 64; }
+
+    bool inBounds(int r, int c) const { return (unsigned)r < (unsigned)rows && (unsigned)c < (unsigned)cols; }
+
+    int cellIndex(int r, int c) const { return r * cols + c; }
+
+    template <typename T>
+    const T& at(const Grid<T>& grid, int r, int c) const { return grid[r][c]; }
+
+    template <typename T>
+    T& at(Grid<T>& grid, int r, int c) const { return grid[r][c]; }
+};
+
+/**
+ * Run kernel(dims) with the compile-time dimensions matching rows x cols, or DynamicGridDims if none do
+ * kernel is a function object with a templated operator()(const Dims&)
+ */
+template <typename Kernel>
+inline auto DispatchGridDims(int rows, int cols, const Kernel& kernel) -> decltype(kernel(DynamicGridDims(rows, cols)))
+{
+    if (rows == MAP_SIZE && cols == MAP_SIZE)
+        return kernel(FixedGridDims<MAP_SIZE, MAP_SIZE>());
+    if (rows == 64 && cols == 64)
+        return kernel(FixedGridDims<64, 64>());
+    return kernel(DynamicGridDims(rows, cols));
+}
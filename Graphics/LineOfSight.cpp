@@ -0,0 +1,161 @@
+#include "LineOfSight.h"
+#include "Shadowcasting.h"
+#include "GridDims.h"
+#include <cstdlib>
+#include <cstring>
+
+LineOfSight::LineOfSight()
+{
+    map = nullptr;
+    engine = FOV_BRESENHAM;
+    frozen = false;
+    windowSize = 2 * VISIBILITY_RANGE + 1;
+    scratch.resize(windowSize, windowSize);
+    wordsPerEntry = scratch.getWordCount();
+}
+
+void LineOfSight::build(const Grid<int>& map)
+{
+    this->map = &map;
+    entryIndex.assign(map.getCellCount(), -1);
+    table.clear();
+}
+
+void LineOfSight::setEngine(int fovEngine)
+{
+    engine = fovEngine;
+    entryIndex.assign(entryIndex.size(), -1);
+    table.clear();
+}
+
+void LineOfSight::computeWindow(int originRow, int originCol, BitGrid& window) const
+{
+    if (engine == FOV_SHADOWCAST)
+    {
+        ComputeShadowcastFOV(*map, originRow, originCol, VISIBILITY_RANGE, window);
+        return;
+    }
+
+    window.clear();
+    for (int i = 0; i < windowSize; i++)
+    {
+        for (int j = 0; j < windowSize; j++)
+        {
+            int r = originRow - VISIBILITY_RANGE + i;
+            int c = originCol - VISIBILITY_RANGE + j;
+            if (map->inBounds(r, c) && traceLine(*map, originRow, originCol, r, c))
+                window.set(i, j);
+        }
+    }
+}
+
+const uint64_t* LineOfSight::entryFor(int originRow, int originCol)
+{
+    int& index = entryIndex[originRow * map->getCols() + originCol];
+    if (index >= 0)
+        return &table[(size_t)index * wordsPerEntry];
+
+    // Frozen: other threads are reading the table - compute on the side without keeping it
+    if (frozen)
+    {
+        thread_local BitGrid sideWindow;
+        sideWindow.resize(windowSize, windowSize);
+        computeWindow(originRow, originCol, sideWindow);
+        return sideWindow.data();
+    }
+
+    computeWindow(originRow, originCol, scratch);
+    index = (int)(table.size() / wordsPerEntry);
+    table.insert(table.end(), scratch.data(), scratch.data() + wordsPerEntry);
+    return &table[(size_t)index * wordsPerEntry];
+}
+
+namespace
+{
+    /**
+     * Merges one cached window into a map-sized grid with the dimensions picked by DispatchGridDims
+     */
+    struct WindowMerge
+    {
+        BitGrid& visible;
+        const uint64_t* window;
+        int windowSize;
+        int top, left;
+
+        template <typename Dims>
+        void operator()(const Dims& dims) const { visible.orWindow(dims, window, windowSize, windowSize, top, left); }
+    };
+}
+
+void LineOfSight::addVisibleFrom(int originRow, int originCol, BitGrid& visible)
+{
+    WindowMerge merge = { visible, entryFor(originRow, originCol), windowSize,
+        originRow - VISIBILITY_RANGE, originCol - VISIBILITY_RANGE };
+    DispatchGridDims(visible.getRows(), visible.getCols(), merge);
+}
+
+bool LineOfSight::canSee(int originRow, int originCol, int targetRow, int targetCol)
+{
+    if (!map->inBounds(targetRow, targetCol))
+        return traceLine(*map, originRow, originCol, targetRow, targetCol);
+
+    int wr = targetRow - originRow + VISIBILITY_RANGE;
+    int wc = targetCol - originCol + VISIBILITY_RANGE;
+    if (wr < 0 || wr >= windowSize || wc < 0 || wc >= windowSize)
+        return false; // Out of range
+
+    const uint64_t* entry = entryFor(originRow, originCol);
+    int wordsPerRow = scratch.getWordsPerRow();
+    return (entry[wr * wordsPerRow + (wc >> 6)] >> (wc & 63)) & 1;
+}
+
+bool LineOfSight::traceLine(const Grid<int>& map, int originRow, int originCol, int targetRow, int targetCol)
+{
+    // Check if target is within visibility range
+    int distance = abs(originRow - targetRow) + abs(originCol - targetCol);
+    if (distance > VISIBILITY_RANGE)
+        return false;
+
+    // Bresenham's line algorithm to check line of sight
+    int x0 = originCol, y0 = originRow;
+    int x1 = targetCol, y1 = targetRow;
+
+    int dx = abs(x1 - x0);
+    int dy = abs(y1 - y0);
+    int sx = (x0 < x1) ? 1 : -1;
+    int sy = (y0 < y1) ? 1 : -1;
+    int err = dx - dy;
+
+    int x = x0, y = y0;
+
+    while (true)
+    {
+        // Check if current cell blocks vision
+        if (x != x0 || y != y0) // Skip starting position
+        {
+            if (map.inBounds(y, x))
+            {
+                int cell = map[y][x];
+                if (cell == ROCK || cell == TREE)
+                    return false; // Vision blocked
+            }
+        }
+
+        if (x == x1 && y == y1)
+            break;
+
+        int e2 = 2 * err;
+        if (e2 > -dy)
+        {
+            err -= dy;
+            x += sx;
+        }
+        if (e2 < dx)
+        {
+            err += dx;
+            y += sy;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include "Definitions.h"
+#include "Grid.h"
+#include "BitGrid.h"
+#include <vector>
+#include <cstdint>
+
+/**
+ * LineOfSight class - Line-of-sight cache for one map
+ * Terrain (ROCK/TREE) never changes during a match, so what a cell can see never changes either.
+ * The visibility of an origin cell is traced once, on first use, and kept for the rest of the match:
+ * afterwards a visibility query is a bit test and a visibility map refresh is a few word copies.
+ * Nothing can be seen beyond VISIBILITY_RANGE, so each entry only covers the window of
+ * 2 * VISIBILITY_RANGE + 1 rows and columns around its origin, and entries are only allocated for
+ * cells units actually stand on - the cache stays small on very large maps
+ */
+class LineOfSight
+{
+private:
+    const Grid<int>* map;            // Map the cache was built for
+    BitGrid scratch;                 // Window being computed
+    int windowSize;                  // Rows and columns of one window
+    int wordsPerEntry;               // Words of one window
+    std::vector<int> entryIndex;     // Origin cell -> entry number in table, -1 until computed
+    std::vector<uint64_t> table;     // Window words of every computed origin, in order of first use
+    int engine;                      // FOV_BRESENHAM or FOV_SHADOWCAST
+    bool frozen;                     // No new entries - origins missing from the cache are computed each time
+
+    /**
+     * Fill window with what can be seen from an origin
+     */
+    void computeWindow(int originRow, int originCol, BitGrid& window) const;
+
+    /**
+     * Window words for an origin, computed on first use
+     */
+    const uint64_t* entryFor(int originRow, int originCol);
+
+public:
+    LineOfSight();
+
+    /**
+     * Start caching for a new map - drops everything computed for the previous one
+     */
+    void build(const Grid<int>& map);
+
+    /**
+     * Select how entries are computed (FOV_BRESENHAM or FOV_SHADOWCAST) - drops cached entries
+     */
+    void setEngine(int fovEngine);
+
+    int getEngine() const { return engine; }
+
+    /**
+     * Compute the entry of an origin now - queries from prepared origins never write to the cache,
+     * so they are safe from several threads at once
+     */
+    void prepare(int originRow, int originCol) { entryFor(originRow, originCol); }
+
+    /**
+     * Stop (or resume) adding entries - while frozen the cache is only read, so several threads may
+     * query it at once; origins that were not prepared are computed without being kept
+     */
+    void setFrozen(bool freeze) { frozen = freeze; }
+
+    /**
+     * Mark every cell visible from (originRow, originCol) in visible (a grid the size of the map)
+     * Only the rows originRow - VISIBILITY_RANGE .. originRow + VISIBILITY_RANGE are touched
+     */
+    void addVisibleFrom(int originRow, int originCol, BitGrid& visible);
+
+    /**
+     * Check if (targetRow, targetCol) is visible from (originRow, originCol)
+     */
+    bool canSee(int originRow, int originCol, int targetRow, int targetCol);
+
+    /**
+     * Bresenham line of sight with range check - the reference the cache is filled from
+     */
+    static bool traceLine(const Grid<int>& map, int originRow, int originCol, int targetRow, int targetCol);
+};
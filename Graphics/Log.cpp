@@ -0,0 +1,337 @@
+#include "Log.h"
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+
+using namespace std;
+
+namespace
+{
+    const size_t RING_SIZE = 4096; // Slots in the ring - must be a power of two
+
+    const char* const LEVEL_NAMES[] = { "DEBUG", "INFO", "WARN", "ERROR" };
+    const char* const CATEGORY_NAMES[] = { "match", "combat", "support", "movement" };
+
+    struct Slot
+    {
+        atomic<size_t> sequence; // Ring position this slot is ready for (see LogRing)
+        char text[LOG_LINE_SIZE];
+        int length;
+        int level;
+        int category;
+    };
+
+    /**
+     * Bounded multi-producer multi-consumer ring (Dmitry Vyukov's design)
+     * Each slot carries a sequence number: a producer may fill slot i when sequence == i,
+     * a consumer may read it when sequence == i + 1. No locks, one CAS per operation
+     */
+    struct LogRing
+    {
+        Slot slots[RING_SIZE];
+        alignas(64) atomic<size_t> enqueuePos;
+        alignas(64) atomic<size_t> dequeuePos;
+
+        LogRing() : enqueuePos(0), dequeuePos(0)
+        {
+            for (size_t i = 0; i < RING_SIZE; i++)
+                slots[i].sequence.store(i, memory_order_relaxed);
+        }
+
+        /**
+         * Claim a free slot, nullptr if the ring is full. Call publish() once the slot is filled
+         */
+        Slot* claim()
+        {
+            size_t pos = enqueuePos.load(memory_order_relaxed);
+            while (true)
+            {
+                Slot* slot = &slots[pos & (RING_SIZE - 1)];
+                size_t seq = slot->sequence.load(memory_order_acquire);
+                intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+
+                if (diff == 0)
+                {
+                    if (enqueuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed))
+                        return slot;
+                }
+                else if (diff < 0)
+                {
+                    return nullptr; // Full
+                }
+                else
+                {
+                    pos = enqueuePos.load(memory_order_relaxed);
+                }
+            }
+        }
+
+        void publish(Slot* slot, size_t pos) { slot->sequence.store(pos + 1, memory_order_release); }
+
+        /**
+         * Take the oldest filled slot, nullptr if the ring is empty. Call release() once it was read
+         */
+        Slot* take(size_t& pos)
+        {
+            pos = dequeuePos.load(memory_order_relaxed);
+            while (true)
+            {
+                Slot* slot = &slots[pos & (RING_SIZE - 1)];
+                size_t seq = slot->sequence.load(memory_order_acquire);
+                intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+
+                if (diff == 0)
+                {
+                    if (dequeuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed))
+                        return slot;
+                }
+                else if (diff < 0)
+                {
+                    return nullptr; // Empty
+                }
+                else
+                {
+                    pos = dequeuePos.load(memory_order_relaxed);
+                }
+            }
+        }
+
+        void release(Slot* slot, size_t pos) { slot->sequence.store(pos + RING_SIZE, memory_order_release); }
+    };
+
+    /**
+     * Process-wide logger state: filters, the ring and the writer thread
+     */
+    class LogState
+    {
+    public:
+        atomic<int> minLevel;
+        atomic<unsigned int> categoryMask;
+        atomic<unsigned long long> dropped;
+        atomic<unsigned long long> queued;
+        atomic<unsigned long long> written;
+        LogRing ring;
+
+        LogState() : minLevel(LOG_LEVEL_DEBUG), categoryMask((1u << LOG_CATEGORY_COUNT) - 1),
+            dropped(0), queued(0), written(0), stopping(false)
+        {
+            writer = thread(&LogState::run, this);
+        }
+
+        ~LogState()
+        {
+            {
+                lock_guard<mutex> lock(wakeMutex);
+                stopping = true;
+            }
+            wake.notify_one();
+            writer.join();
+        }
+
+        void notify() { wake.notify_one(); }
+
+    private:
+        thread writer;
+        mutex wakeMutex; // Only used to sleep the writer - producers never take it
+        condition_variable wake;
+        bool stopping;
+
+        /**
+         * Write every queued line, returns false if there was nothing to write
+         */
+        bool drain()
+        {
+            bool any = false;
+            size_t pos;
+            Slot* slot;
+
+            while ((slot = ring.take(pos)) != nullptr)
+            {
+                fprintf(stdout, "[%s %s] %.*s\n", LEVEL_NAMES[slot->level], CATEGORY_NAMES[slot->category],
+                    slot->length, slot->text);
+                ring.release(slot, pos);
+                written.fetch_add(1, memory_order_release);
+                any = true;
+            }
+
+            if (any)
+                fflush(stdout);
+            return any;
+        }
+
+        void run()
+        {
+            unsigned long long reportedDrops = 0;
+
+            while (true)
+            {
+                drain();
+
+                unsigned long long drops = dropped.load(memory_order_relaxed);
+                if (drops != reportedDrops)
+                {
+                    fprintf(stdout, "[WARN log] %llu lines dropped (ring full)\n", drops - reportedDrops);
+                    fflush(stdout);
+                    reportedDrops = drops;
+                }
+
+                unique_lock<mutex> lock(wakeMutex);
+                if (stopping)
+                    break;
+                // Producers never notify (only flush() and shutdown do), so poll with a short timeout
+                wake.wait_for(lock, chrono::milliseconds(2));
+                if (stopping)
+                    break;
+            }
+
+            drain();
+        }
+    };
+
+    LogState& State()
+    {
+        static LogState state;
+        return state;
+    }
+}
+
+// LogLine
+void LogLine::append(const char* s, size_t n)
+{
+    size_t room = LOG_LINE_SIZE - length;
+    if (n > room)
+        n = room;
+    memcpy(text + length, s, n);
+    length += (int)n;
+}
+
+LogLine& LogLine::operator<<(const char* s)
+{
+    append(s, strlen(s));
+    return *this;
+}
+
+LogLine& LogLine::operator<<(char c)
+{
+    append(&c, 1);
+    return *this;
+}
+
+LogLine& LogLine::operator<<(bool b)
+{
+    // Same output as std::cout without boolalpha
+    append(b ? "1" : "0", 1);
+    return *this;
+}
+
+LogLine& LogLine::operator<<(int v)
+{
+    return *this << (long long)v;
+}
+
+LogLine& LogLine::operator<<(unsigned int v)
+{
+    return *this << (unsigned long long)v;
+}
+
+LogLine& LogLine::operator<<(long v)
+{
+    return *this << (long long)v;
+}
+
+LogLine& LogLine::operator<<(unsigned long v)
+{
+    return *this << (unsigned long long)v;
+}
+
+LogLine& LogLine::operator<<(long long v)
+{
+    char buffer[24];
+    int n = snprintf(buffer, sizeof(buffer), "%lld", v);
+    append(buffer, n);
+    return *this;
+}
+
+LogLine& LogLine::operator<<(unsigned long long v)
+{
+    char buffer[24];
+    int n = snprintf(buffer, sizeof(buffer), "%llu", v);
+    append(buffer, n);
+    return *this;
+}
+
+LogLine& LogLine::operator<<(double v)
+{
+    // %g matches the default std::ostream formatting (6 significant digits)
+    char buffer[32];
+    int n = snprintf(buffer, sizeof(buffer), "%g", v);
+    append(buffer, n);
+    return *this;
+}
+
+// Logger
+bool Logger::isEnabled(int level, int category)
+{
+    LogState& state = State();
+    return level >= state.minLevel.load(memory_order_relaxed) &&
+        (state.categoryMask.load(memory_order_relaxed) & (1u << category)) != 0;
+}
+
+void Logger::setLevel(int level)
+{
+    State().minLevel.store(level, memory_order_relaxed);
+}
+
+void Logger::setCategoryEnabled(int category, bool enabled)
+{
+    LogState& state = State();
+    if (enabled)
+        state.categoryMask.fetch_or(1u << category, memory_order_relaxed);
+    else
+        state.categoryMask.fetch_and(~(1u << category), memory_order_relaxed);
+}
+
+void Logger::write(const LogLine& line)
+{
+    LogState& state = State();
+
+    Slot* slot = state.ring.claim();
+    if (slot == nullptr)
+    {
+        state.dropped.fetch_add(1, memory_order_relaxed);
+        return;
+    }
+
+    // claim() moved enqueuePos past this slot's position; the slot's sequence still holds it
+    size_t pos = slot->sequence.load(memory_order_relaxed);
+    memcpy(slot->text, line.text, line.length);
+    slot->length = line.length;
+    slot->level = line.level;
+    slot->category = line.category;
+    state.ring.publish(slot, pos);
+
+    // No notify here - waking the writer is a syscall; it polls the ring every couple of milliseconds
+    state.queued.fetch_add(1, memory_order_relaxed);
+}
+
+void Logger::flush()
+{
+    LogState& state = State();
+    unsigned long long target = state.queued.load(memory_order_relaxed);
+
+    while (state.written.load(memory_order_acquire) < target)
+    {
+        state.notify();
+        this_thread::sleep_for(chrono::milliseconds(1));
+    }
+}
+
+unsigned long long Logger::droppedCount()
+{
+    return State().dropped.load(memory_order_relaxed);
+}
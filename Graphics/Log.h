@@ -0,0 +1,138 @@
+#pragma once
+#include <cstddef>
+
+/**
+ * Asynchronous logger
+ * Log sites format into a fixed-size record and push it onto a lock-free ring buffer; a background
+ * thread drains the ring to stdout. The simulation thread never waits for I/O - when the ring is
+ * full the record is dropped and counted.
+ *
+ * Usage: LOG_INFO(LOG_COMBAT, "Team " << team << " shoots for " << damage);
+ *
+ * Levels below LOG_COMPILE_LEVEL are removed by the preprocessor (define it on the command line,
+ * e.g. -DLOG_COMPILE_LEVEL=LOG_LEVEL_WARN). Levels and categories can also be switched at runtime
+ */
+
+// Log levels (preprocessor values so they can be compared in #if)
+#define LOG_LEVEL_DEBUG 0
+#define LOG_LEVEL_INFO  1
+#define LOG_LEVEL_WARN  2
+#define LOG_LEVEL_ERROR 3
+#define LOG_LEVEL_OFF   4
+
+#ifndef LOG_COMPILE_LEVEL
+#define LOG_COMPILE_LEVEL LOG_LEVEL_DEBUG
+#endif
+
+// Log categories
+const int LOG_MATCH = 0;    // Match start / end
+const int LOG_COMBAT = 1;   // Shots, grenades, projectiles
+const int LOG_SUPPORT = 2;  // Medic and supply work, commander orders
+const int LOG_MOVEMENT = 3; // Tree escapes, loop breaking, stuck units
+const int LOG_CATEGORY_COUNT = 4;
+
+const int LOG_LINE_SIZE = 240; // Longest message kept, longer ones are cut
+
+/**
+ * LogLine - One formatted log record, built on the stack by the LOG_* macros
+ */
+class LogLine
+{
+private:
+    char text[LOG_LINE_SIZE];
+    int length;
+    int level;
+    int category;
+
+    void append(const char* s, size_t n);
+
+    friend class Logger;
+
+public:
+    LogLine(int logLevel, int logCategory) : length(0), level(logLevel), category(logCategory) {}
+
+    LogLine& operator<<(const char* s);
+    LogLine& operator<<(char c);
+    LogLine& operator<<(bool b);
+    LogLine& operator<<(int v);
+    LogLine& operator<<(unsigned int v);
+    LogLine& operator<<(long v);
+    LogLine& operator<<(unsigned long v);
+    LogLine& operator<<(long long v);
+    LogLine& operator<<(unsigned long long v);
+    LogLine& operator<<(double v);
+};
+
+/**
+ * Logger - Process-wide log sink
+ */
+class Logger
+{
+public:
+    /**
+     * Check if messages of this level and category are currently written
+     */
+    static bool isEnabled(int level, int category);
+
+    /**
+     * Minimum level written at runtime (default LOG_LEVEL_DEBUG)
+     */
+    static void setLevel(int level);
+
+    /**
+     * Turn one category on or off at runtime (all are on by default)
+     */
+    static void setCategoryEnabled(int category, bool enabled);
+
+    /**
+     * Queue a finished line for the writer thread (never blocks, drops the line if the ring is full)
+     */
+    static void write(const LogLine& line);
+
+    /**
+     * Wait until every queued line has been written
+     */
+    static void flush();
+
+    /**
+     * Number of lines dropped because the ring was full
+     */
+    static unsigned long long droppedCount();
+};
+
+#define LOG_AT(lvl, cat, message) \
+    do \
+    { \
+        if (Logger::isEnabled(lvl, cat)) \
+        { \
+            LogLine logLine_(lvl, cat); \
+            logLine_ << message; \
+            Logger::write(logLine_); \
+        } \
+    } while (0)
+
+#define LOG_DISCARD(cat, message) do { } while (0)
+
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(cat, message) LOG_AT(LOG_LEVEL_DEBUG, cat, message)
+#else
+#define LOG_DEBUG(cat, message) LOG_DISCARD(cat, message)
+#endif
+
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_INFO
+#define LOG_INFO(cat, message) LOG_AT(LOG_LEVEL_INFO, cat, message)
+#else
+#define LOG_INFO(cat, message) LOG_DISCARD(cat, message)
+#endif
+
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_WARN
+#define LOG_WARN(cat, message) LOG_AT(LOG_LEVEL_WARN, cat, message)
+#else
+#define LOG_WARN(cat, message) LOG_DISCARD(cat, message)
+#endif
+
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_ERROR
+#define LOG_ERROR(cat, message) LOG_AT(LOG_LEVEL_ERROR, cat, message)
+#else
+#define LOG_ERROR(cat, message) LOG_DISCARD(cat, message)
+#endif
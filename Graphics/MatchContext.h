@@ -0,0 +1,36 @@
+#pragma once
+
+class LineOfSight;
+class BitGrid;
+class OccupancyGrid;
+class SpatialIndex;
+class UnitStore;
+class TeamRoster;
+struct TeamIntents;
+class PathCache;
+class DepotField;
+class TelemetrySink;
+class Random;
+
+/**
+ * MatchContext - Per-match services shared by all units of one Simulation
+ * The simulation hands it to every unit it spawns. Units also work without one
+ * (every service pointer may be null) and then compute everything directly
+ */
+struct MatchContext
+{
+    LineOfSight* lineOfSight; // Cached line-of-sight for the current map
+    const BitGrid* teamVisibility; // Cells seen by any alive unit of each team when the frame began, indexed by team
+    OccupancyGrid* occupancy; // Cell -> alive unit standing on it
+    SpatialIndex* spatial;    // Alive units bucketed by area, team and type
+    UnitStore* store;         // Hot unit state as arrays - units write their changes through
+    TeamRoster* rosters;      // Alive units of each team by role, indexed by team
+    TelemetrySink* telemetry; // Binary event stream, null when not recording
+    TeamIntents* intents;     // Per-team intent buffers while the teams update in parallel, null otherwise
+    PathCache* pathCaches;    // Per-team A* results of the current safety maps, null = always search
+    DepotField* medicalFields; // Per-team distance fields of the medical depots, null = search the map
+    DepotField* ammoFields;    // Per-team distance fields of the ammo depots, null = search the map
+    Random* rng;              // Seeded generator of the match
+
+    MatchContext() : lineOfSight(nullptr), teamVisibility(nullptr), occupancy(nullptr), spatial(nullptr), store(nullptr), rosters(nullptr), telemetry(nullptr), intents(nullptr), pathCaches(nullptr), medicalFields(nullptr), ammoFields(nullptr), rng(nullptr) {}
+};
@@ -1,6 +1,17 @@
 #include "Medic.h"
 #include "Warrior.h"
-#include <iostream>
+#include "Supply.h"
+#include "Commander.h"
+#include "TeamRoster.h"
+#include "DepotField.h"
+#include "Log.h"
+#include "Telemetry.h"
+
+namespace
+{
+    thread_local std::vector<Unit*> neighbours; // Range query results, reused on the thread
+    thread_local std::vector<Unit*> candidates; // Non-medic team members, reused on the thread
+}
 
 Medic::Medic(int startRow, int startCol, int teamId)
     : Unit(startRow, startCol, teamId, MEDIC, 'M')
@@ -14,8 +25,8 @@ Medic::Medic(int startRow, int startCol, int teamId)
 }
 
 void Medic::update(
-    int map[][MAP_SIZE],
-    int safetyMap[][MAP_SIZE],
+    const Grid<int>& map,
+    const Grid<int>& safetyMap,
     std::vector<Unit*>& allUnits)
 {
     if (!alive)
@@ -37,7 +48,7 @@ void Medic::update(
         pathIndex = 0;
     }
 
-    if (checkTreeHidingLimit(map, allUnits))
+    if (checkTreeHidingLimit(map))
     {
         escapingTree = true;
         currentPath.clear();
@@ -73,8 +84,7 @@ void Medic::update(
 
                 if (isPositionAvailable(map, nextPos.first, nextPos.second, allUnits))
                 {
-                    row = nextPos.first;
-                    col = nextPos.second;
+                    setPosition(nextPos.first, nextPos.second);
                     pathIndex++;
                 }
                 else
@@ -90,8 +100,7 @@ void Medic::update(
 
                         if (isPositionAvailable(map, newRow, newCol, allUnits) && map[newRow][newCol] != TREE)
                         {
-                            row = newRow;
-                            col = newCol;
+                            setPosition(newRow, newCol);
                             currentPath.clear();
                             pathIndex = 0;
                             moved = true;
@@ -119,8 +128,7 @@ void Medic::update(
 
                 if (isPositionAvailable(map, newRow, newCol, allUnits) && map[newRow][newCol] != TREE)
                 {
-                    row = newRow;
-                    col = newCol;
+                    setPosition(newRow, newCol);
                     break;
                 }
             }
@@ -158,8 +166,7 @@ void Medic::update(
                     nextPos = currentPath[pathIndex];
                     if (isPositionAvailable(map, nextPos.first, nextPos.second, allUnits))
                     {
-                        row = nextPos.first;
-                        col = nextPos.second;
+                        setPosition(nextPos.first, nextPos.second);
                         pathIndex++;
                     }
                     else
@@ -173,7 +180,7 @@ void Medic::update(
         else
         {
             int bestRow = row, bestCol = col;
-            int minDanger = (safetyMap != nullptr) ? safetyMap[row][col] : 999;
+            int minDanger = safetyMap[row][col];
 
             int deltaRow[] = { 0, -1, 1, 0 };
             int deltaCol[] = { 1, 0, 0, -1 };
@@ -185,7 +192,7 @@ void Medic::update(
 
                 if (isPositionAvailable(map, newRow, newCol, allUnits))
                 {
-                    int danger = (safetyMap != nullptr) ? safetyMap[newRow][newCol] : 0;
+                    int danger = safetyMap[newRow][newCol];
                     if (danger < minDanger)
                     {
                         minDanger = danger;
@@ -197,8 +204,7 @@ void Medic::update(
 
             if (bestRow != row || bestCol != col)
             {
-                row = bestRow;
-                col = bestCol;
+                setPosition(bestRow, bestCol);
             }
         }
         return;
@@ -206,45 +212,43 @@ void Medic::update(
 
     if (healingCharges > 0 && !needsRecharge)
     {
-        for (auto unit : allUnits)
+        findUnitsInRange(1, team, allUnits, neighbours);
+        for (auto unit : neighbours)
         {
-            if (unit->getTeam() == team && unit->isAlive() && unit->getUnitType() == WARRIOR)
+            if (unit->getUnitType() == WARRIOR)
             {
-                int dist = abs(row - unit->getRow()) + abs(col - unit->getCol());
-                if (dist <= 1 && unit->getHealth() < MAX_HEALTH)
+                if (unit->getHealth() < MAX_HEALTH)
                 {
-                    std::cout << "Team " << team << " Medic found adjacent wounded warrior! Healing immediately!" << std::endl;
+                    LOG_INFO(LOG_SUPPORT, "Team " << team << " Medic found adjacent wounded warrior! Healing immediately!");
                     unit->heal(MEDIC_HEAL_AMOUNT);
+                    recordEvent(EVENT_HEAL, unit->getId(), unit->getHealth());
                     healingCharges--;
                     hasOrder = false;
                     currentPath.clear();
                     pathIndex = 0;
                     needsRecharge = true;
-                    std::cout << "Team " << team << " Medic healed warrior to " << unit->getHealth()
-                        << " HP! Returning to depot." << std::endl;
+                    LOG_INFO(LOG_SUPPORT, "Team " << team << " Medic healed warrior to " << unit->getHealth()
+                        << " HP! Returning to depot.");
                     return;
                 }
             }
         }
     }
 
-    static int debugCounter = 0;
+    thread_local int debugCounter = 0;
     if (debugCounter++ % 120 == 0)
     {
-        std::cout << "=== Team " << team << " Medic at (" << row << "," << col
+        LOG_DEBUG(LOG_SUPPORT, "=== Team " << team << " Medic at (" << row << "," << col
             << ") | Order:" << hasOrder << " Recharge:" << needsRecharge
-            << " Charges:" << healingCharges << " HP:" << health << " ===" << std::endl;
+            << " Charges:" << healingCharges << " HP:" << health << " ===");
 
-        for (auto unit : allUnits)
+        for (auto warrior : getTeamRoster(allUnits).getWarriors())
         {
-            if (unit->getTeam() == team && unit->isAlive() && unit->getUnitType() == WARRIOR)
+            int dist = abs(row - warrior->getRow()) + abs(col - warrior->getCol());
+            if (dist <= 2)
             {
-                int dist = abs(row - unit->getRow()) + abs(col - unit->getCol());
-                if (dist <= 2)
-                {
-                    std::cout << "  -> Warrior at (" << unit->getRow() << "," << unit->getCol()
-                        << ") dist:" << dist << " HP:" << unit->getHealth() << std::endl;
-                }
+                LOG_DEBUG(LOG_SUPPORT, "  -> Warrior at (" << warrior->getRow() << "," << warrior->getCol()
+                    << ") dist:" << dist << " HP:" << warrior->getHealth());
             }
         }
     }
@@ -265,18 +269,18 @@ void Medic::update(
                 if (healingCharges < MAX_MEDIC_CHARGES)
                 {
                     healingCharges = MAX_MEDIC_CHARGES;
-                    std::cout << ">>> Team " << team << " Medic RECHARGED at depot! Charges: "
-                        << healingCharges << " <<<" << std::endl;
+                    LOG_INFO(LOG_SUPPORT, ">>> Team " << team << " Medic RECHARGED at depot! Charges: "
+                        << healingCharges << " <<<");
                 }
 
                 needsRecharge = false;
                 currentPath.clear();
                 pathIndex = 0;
 
-                int currentDanger = (safetyMap != nullptr) ? safetyMap[row][col] : 0;
+                int currentDanger = safetyMap[row][col];
                 if (currentDanger > DANGER_THRESHOLD)
                 {
-                    std::cout << "Team " << team << " Medic at depot detected danger! Escaping..." << std::endl;
+                    LOG_DEBUG(LOG_SUPPORT, "Team " << team << " Medic at depot detected danger! Escaping...");
 
                     int bestRow = row, bestCol = col;
                     int minDanger = currentDanger;
@@ -291,7 +295,7 @@ void Medic::update(
 
                         if (isPositionAvailable(map, newRow, newCol, allUnits))
                         {
-                            int danger = (safetyMap != nullptr) ? safetyMap[newRow][newCol] : 0;
+                            int danger = safetyMap[newRow][newCol];
                             if (danger < minDanger)
                             {
                                 minDanger = danger;
@@ -303,45 +307,43 @@ void Medic::update(
 
                     if (bestRow != row || bestCol != col)
                     {
-                        row = bestRow;
-                        col = bestCol;
+                        setPosition(bestRow, bestCol);
                     }
                     return;
                 }
 
-                int aliveWarriors = 0;
-                for (auto u : allUnits)
-                {
-                    if (u->getTeam() == team && u->isAlive() && u->getUnitType() == WARRIOR)
-                        aliveWarriors++;
-                }
+                const TeamRoster& roster = getTeamRoster(allUnits);
 
-                if (aliveWarriors > 0)
+                if (!roster.getWarriors().empty())
                 {
-                    for (auto unit : allUnits)
+                    for (auto warrior : roster.getWarriors())
                     {
-                        if (unit->getTeam() == team && unit->isAlive() &&
-                            unit->getUnitType() == WARRIOR && unit->getHealth() < CRITICAL_HEALTH)
+                        if (warrior->getHealth() < CRITICAL_HEALTH)
                         {
-                            std::cout << "Team " << team << " Medic at depot sees wounded warrior at ("
-                                << unit->getRow() << "," << unit->getCol()
-                                << ") HP:" << unit->getHealth() << "! Leaving depot!" << std::endl;
+                            LOG_DEBUG(LOG_SUPPORT, "Team " << team << " Medic at depot sees wounded warrior at ("
+                                << warrior->getRow() << "," << warrior->getCol()
+                                << ") HP:" << warrior->getHealth() << "! Leaving depot!");
                             hasOrder = true;
-                            targetUnitRow = unit->getRow();
-                            targetUnitCol = unit->getCol();
+                            targetUnitRow = warrior->getRow();
+                            targetUnitCol = warrior->getCol();
                             return;
                         }
                     }
                 }
                 else
                 {
-                    for (auto unit : allUnits)
+                    // Commander first, then the supply units - the id order of the team
+                    candidates.clear();
+                    if (roster.getCommander() != nullptr)
+                        candidates.push_back(roster.getCommander());
+                    candidates.insert(candidates.end(), roster.getSupplies().begin(), roster.getSupplies().end());
+
+                    for (auto unit : candidates)
                     {
-                        if (unit->getTeam() == team && unit->isAlive() &&
-                            unit->getHealth() < CRITICAL_HEALTH && unit->getUnitType() != MEDIC)
+                        if (unit->getHealth() < CRITICAL_HEALTH)
                         {
-                            std::cout << "Team " << team << " Medic (no warriors left) helping " << unit->getSymbol()
-                                << " at (" << unit->getRow() << "," << unit->getCol() << ")" << std::endl;
+                            LOG_DEBUG(LOG_SUPPORT, "Team " << team << " Medic (no warriors left) helping " << unit->getSymbol()
+                                << " at (" << unit->getRow() << "," << unit->getCol() << ")");
                             hasOrder = true;
                             targetUnitRow = unit->getRow();
                             targetUnitCol = unit->getCol();
@@ -353,13 +355,20 @@ void Medic::update(
                 return;
             }
 
+            // Downhill along the depot field - no search per trip
+            if (context != nullptr && context->medicalFields != nullptr &&
+                descendField(map, safetyMap, context->medicalFields[team], allUnits))
+            {
+                return;
+            }
+
             if (currentPath.empty() || pathIndex >= currentPath.size())
             {
-                static int moveLogCounter = 0;
+                thread_local int moveLogCounter = 0;
                 if (moveLogCounter++ % 60 == 0)
                 {
-                    std::cout << "Team " << team << " Medic at (" << row << "," << col
-                        << ") calculating A* path to depot at (" << medicalDepotRow << "," << medicalDepotCol << ")" << std::endl;
+                    LOG_DEBUG(LOG_SUPPORT, "Team " << team << " Medic at (" << row << "," << col
+                        << ") calculating A* path to depot at (" << medicalDepotRow << "," << medicalDepotCol << ")");
                 }
                 currentPath = findPathAStar(map, safetyMap, medicalDepotRow, medicalDepotCol, allUnits);
                 pathIndex = 0;
@@ -380,8 +389,7 @@ void Medic::update(
                     nextPos = currentPath[pathIndex];
                     if (isPositionAvailable(map, nextPos.first, nextPos.second, allUnits))
                     {
-                        row = nextPos.first;
-                        col = nextPos.second;
+                        setPosition(nextPos.first, nextPos.second);
                         pathIndex++;
                     }
                     else
@@ -399,12 +407,12 @@ void Medic::update(
     }
 
     Unit* adjacentWarrior = nullptr;
-    for (auto unit : allUnits)
+    findUnitsInRange(1, team, allUnits, neighbours);
+    for (auto unit : neighbours)
     {
-        if (unit->getTeam() == team && unit->isAlive() && unit->getUnitType() == WARRIOR)
+        if (unit->getUnitType() == WARRIOR)
         {
-            int distToUnit = abs(row - unit->getRow()) + abs(col - unit->getCol());
-            if (distToUnit <= 1 && unit->getHealth() < MAX_HEALTH)
+            if (unit->getHealth() < MAX_HEALTH)
             {
                 adjacentWarrior = unit;
                 break;
@@ -414,13 +422,14 @@ void Medic::update(
 
     if (adjacentWarrior != nullptr)
     {
-        std::cout << "Team " << team << " Medic found adjacent warrior to heal!" << std::endl;
+        LOG_DEBUG(LOG_SUPPORT, "Team " << team << " Medic found adjacent warrior to heal!");
         adjacentWarrior->heal(MEDIC_HEAL_AMOUNT);
+        recordEvent(EVENT_HEAL, adjacentWarrior->getId(), adjacentWarrior->getHealth());
         healingCharges--;
-        std::cout << "Team " << team << " Medic healed warrior at ("
+        LOG_INFO(LOG_SUPPORT, "Team " << team << " Medic healed warrior at ("
             << adjacentWarrior->getRow() << "," << adjacentWarrior->getCol()
             << ") for " << MEDIC_HEAL_AMOUNT << " HP! Charges left: "
-            << healingCharges << std::endl;
+            << healingCharges);
 
         hasOrder = false;
         currentPath.clear();
@@ -428,19 +437,18 @@ void Medic::update(
         targetUnitRow = targetUnitCol = -1;
         needsRecharge = true;
 
-        std::cout << "Team " << team << " Medic returning to depot to wait for next order!" << std::endl;
+        LOG_DEBUG(LOG_SUPPORT, "Team " << team << " Medic returning to depot to wait for next order!");
         return;
     }
 
     Unit* targetWarrior = nullptr;
-    for (auto unit : allUnits)
+    for (auto warrior : getTeamRoster(allUnits).getWarriors())
     {
-        if (unit->getTeam() == team && unit->isAlive() &&
-            unit->getUnitType() == WARRIOR && unit->getHealth() < CRITICAL_HEALTH)
+        if (warrior->getHealth() < CRITICAL_HEALTH)
         {
-            targetWarrior = unit;
-            targetUnitRow = unit->getRow();
-            targetUnitCol = unit->getCol();
+            targetWarrior = warrior;
+            targetUnitRow = warrior->getRow();
+            targetUnitCol = warrior->getCol();
             break;
         }
     }
@@ -452,7 +460,7 @@ void Medic::update(
         pathIndex = 0;
         targetUnitRow = targetUnitCol = -1;
         needsRecharge = true;
-        std::cout << "Team " << team << " Medic: No wounded warriors found, returning to depot" << std::endl;
+        LOG_DEBUG(LOG_SUPPORT, "Team " << team << " Medic: No wounded warriors found, returning to depot");
         return;
     }
 
@@ -477,8 +485,7 @@ void Medic::update(
             nextPos = currentPath[pathIndex];
             if (isPositionAvailable(map, nextPos.first, nextPos.second, allUnits))
             {
-                row = nextPos.first;
-                col = nextPos.second;
+                setPosition(nextPos.first, nextPos.second);
                 pathIndex++;
             }
             else
@@ -501,26 +508,34 @@ void Medic::receiveOrder(int targetRow, int targetCol)
         pathIndex = 0;
         needsRecharge = false;
 
-        std::cout << "Team " << team << " Medic received order to heal unit at ("
+        LOG_INFO(LOG_SUPPORT, "Team " << team << " Medic received order to heal unit at ("
             << targetRow << "," << targetCol << "). Charges: " << healingCharges
-            << " - Leaving depot!" << std::endl;
+            << " - Leaving depot!");
     }
     else
     {
-        std::cout << "Team " << team << " Medic cannot accept order - out of charges!" << std::endl;
+        LOG_INFO(LOG_SUPPORT, "Team " << team << " Medic cannot accept order - out of charges!");
     }
 }
 
-void Medic::findMedicalDepot(int map[][MAP_SIZE])
+void Medic::findMedicalDepot(const Grid<int>& map)
 {
-    int teamStartRow = (team == TEAM_BLUE) ? 0 : MAP_SIZE - 1;
-    int teamStartCol = (team == TEAM_BLUE) ? 0 : MAP_SIZE - 1;
+    // The match already knows where the team's depot is
+    if (context != nullptr && context->medicalFields != nullptr)
+    {
+        medicalDepotRow = context->medicalFields[team].getDepotRow();
+        medicalDepotCol = context->medicalFields[team].getDepotCol();
+        return;
+    }
+
+    int teamStartRow = (team == TEAM_BLUE) ? 0 : map.getRows() - 1;
+    int teamStartCol = (team == TEAM_BLUE) ? 0 : map.getCols() - 1;
 
     int minDistFromStart = 9999;
 
-    for (int i = 0; i < MAP_SIZE; i++)
+    for (int i = 0; i < map.getRows(); i++)
     {
-        for (int j = 0; j < MAP_SIZE; j++)
+        for (int j = 0; j < map.getCols(); j++)
         {
             if (map[i][j] == MEDICAL_DEPOT)
             {
@@ -538,7 +553,7 @@ void Medic::findMedicalDepot(int map[][MAP_SIZE])
 
     if (medicalDepotRow != -1)
     {
-        std::cout << "Team " << team << " Medic found team depot at ("
-            << medicalDepotRow << "," << medicalDepotCol << ")" << std::endl;
+        LOG_DEBUG(LOG_SUPPORT, "Team " << team << " Medic found team depot at ("
+            << medicalDepotRow << "," << medicalDepotCol << ")");
     }
 }
\ No newline at end of file
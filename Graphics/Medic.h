@@ -27,8 +27,8 @@ public:
      * Update medic behavior
      */
     void update(
-        int map[][MAP_SIZE],
-        int safetyMap[][MAP_SIZE],
+        const Grid<int>& map,
+        const Grid<int>& safetyMap,
         std::vector<Unit*>& allUnits
     ) override;
 
@@ -40,7 +40,7 @@ public:
     /**
      * Find medical depot location
      */
-    void findMedicalDepot(int map[][MAP_SIZE]);
+    void findMedicalDepot(const Grid<int>& map);
 
     /**
      * Check if medic has active order
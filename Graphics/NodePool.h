@@ -0,0 +1,72 @@
+#pragma once
+#include "Node.h"
+#include <vector>
+#include <memory>
+
+/**
+ * NodePool class - Bump allocator for search nodes
+ * Nodes live in fixed-size blocks that are allocated on first use and kept for later searches, so
+ * node pointers stay valid while the pool grows and a search on a large map only pays for the
+ * nodes it actually creates. reset() releases all nodes at once
+ */
+class NodePool
+{
+private:
+    static const int BLOCK_SIZE = 4096;
+
+    std::vector<std::unique_ptr<Node[]>> blocks; // Never freed or moved while a search holds pointers
+    int used;
+
+    Node* next();
+
+public:
+    NodePool() : used(0) {}
+
+    /**
+     * Release every node - capacity is a hint of how many nodes the next search may need
+     */
+    void reset(int capacity);
+
+    /**
+     * Create a start node at (r, c)
+     */
+    Node* create(int r, int c);
+
+    /**
+     * Create a child node of parentNode at (newRow, newCol)
+     */
+    Node* create(Node* parentNode, int newRow, int newCol);
+
+    int size() const { return used; }
+};
+
+// Implementation:
+inline void NodePool::reset(int capacity)
+{
+    // Small searches are the common case - keep at least one block ready, grow the rest on demand
+    if (blocks.empty() && capacity > 0)
+        blocks.emplace_back(new Node[BLOCK_SIZE]);
+    used = 0;
+}
+
+inline Node* NodePool::next()
+{
+    int block = used / BLOCK_SIZE;
+    if (block == (int)blocks.size())
+        blocks.emplace_back(new Node[BLOCK_SIZE]);
+    return &blocks[block][used++ % BLOCK_SIZE];
+}
+
+inline Node* NodePool::create(int r, int c)
+{
+    Node* node = next();
+    *node = Node(r, c);
+    return node;
+}
+
+inline Node* NodePool::create(Node* parentNode, int newRow, int newCol)
+{
+    Node* node = next();
+    *node = Node(parentNode, newRow, newCol);
+    return node;
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include "Definitions.h"
+#include "Grid.h"
+
+const int NO_UNIT = -1;
+
+/**
+ * OccupancyGrid class - Which alive unit stands on each map cell
+ * Kept up to date by Unit::setPosition and Unit::takeDamage, so occupancy checks are a lookup
+ * instead of a scan over all units. Cells also count their units, so the grid stays exact
+ * even if two units ever end up sharing a cell
+ */
+class OccupancyGrid
+{
+private:
+    Grid<int> unitId;          // Last unit that entered the cell, NO_UNIT if empty
+    Grid<unsigned char> count; // Alive units on the cell
+
+public:
+    /**
+     * Size the grid to rows x cols with no units on it
+     */
+    void reset(int rows, int cols);
+
+    /**
+     * Unit id entered cell (r, c)
+     */
+    void place(int id, int r, int c);
+
+    /**
+     * Unit id left cell (r, c) or died there
+     */
+    void vacate(int id, int r, int c);
+
+    /**
+     * Unit standing on cell (r, c), NO_UNIT if empty
+     */
+    int get(int r, int c) const { return unitId[r][c]; }
+
+    /**
+     * Number of alive units on cell (r, c)
+     */
+    int countAt(int r, int c) const { return count[r][c]; }
+};
+
+// Implementation:
+inline void OccupancyGrid::reset(int rows, int cols)
+{
+    unitId.resize(rows, cols, NO_UNIT);
+    count.resize(rows, cols, 0);
+}
+
+inline void OccupancyGrid::place(int id, int r, int c)
+{
+    unitId[r][c] = id;
+    count[r][c]++;
+}
+
+inline void OccupancyGrid::vacate(int id, int r, int c)
+{
+    if (count[r][c] > 0)
+        count[r][c]--;
+
+    // Only forget the id if it is ours - a unit sharing the cell keeps it
+    if (unitId[r][c] == id)
+        unitId[r][c] = NO_UNIT;
+}
@@ -0,0 +1,166 @@
+#pragma once
+#include "Node.h"
+#include "CompareNodes.h"
+#include <vector>
+#include <utility>
+
+/**
+ * OpenList class - Indexed binary min-heap of nodes for the A* open list
+ * Every node is keyed by its cell index (row * width + col), so membership tests,
+ * lookups and decrease-key are done through a position table instead of scanning the heap
+ */
+class OpenList
+{
+private:
+    std::vector<Node*> heap;     // Binary heap ordered by F (lowest F on top)
+    std::vector<int> heapIndex;  // Cell index -> position in heap, -1 if not open
+    std::vector<int> heapCells;  // Position in heap -> cell index
+    CompareNodes compare;
+
+    void swapEntries(int a, int b);
+    void siftUp(int pos);
+    void siftDown(int pos);
+
+public:
+    /**
+     * Constructor
+     * @param numCells - number of cells in the map (size of the position table)
+     */
+    explicit OpenList(int numCells = 0);
+
+    /**
+     * Prepare an empty open list for a map with numCells cells (reallocates only if the size changed)
+     */
+    void reset(int numCells);
+
+    bool empty() const { return heap.empty(); }
+    int size() const { return (int)heap.size(); }
+
+    /**
+     * Check if cell currently has a node in the open list
+     */
+    bool contains(int cell) const { return heapIndex[cell] != -1; }
+
+    /**
+     * Get the open node for a cell (cell must be open)
+     */
+    Node* get(int cell) const { return heap[heapIndex[cell]]; }
+
+    /**
+     * Insert a node for a cell that is not open yet
+     */
+    void push(Node* node, int cell);
+
+    /**
+     * Node with the lowest F value
+     */
+    Node* top() const { return heap.front(); }
+
+    /**
+     * Remove and return the node with the lowest F value
+     */
+    Node* pop();
+
+    /**
+     * Restore heap order after the G (and so F) of an open node was lowered
+     */
+    void decreaseKey(int cell);
+
+    /**
+     * Empty the open list (nodes belong to the search's NodePool and are not deleted here)
+     */
+    void clear();
+};
+
+// Implementation:
+inline OpenList::OpenList(int numCells)
+    : heapIndex(numCells, -1)
+{
+}
+
+inline void OpenList::reset(int numCells)
+{
+    clear();
+    if ((int)heapIndex.size() != numCells)
+        heapIndex.assign(numCells, -1);
+}
+
+inline void OpenList::swapEntries(int a, int b)
+{
+    std::swap(heap[a], heap[b]);
+    std::swap(heapCells[a], heapCells[b]);
+    heapIndex[heapCells[a]] = a;
+    heapIndex[heapCells[b]] = b;
+}
+
+inline void OpenList::siftUp(int pos)
+{
+    while (pos > 0)
+    {
+        int parent = (pos - 1) / 2;
+        if (!compare(heap[parent], heap[pos]))
+            break;
+        swapEntries(parent, pos);
+        pos = parent;
+    }
+}
+
+inline void OpenList::siftDown(int pos)
+{
+    int count = (int)heap.size();
+    while (true)
+    {
+        int left = 2 * pos + 1;
+        int right = left + 1;
+        int best = pos;
+
+        if (left < count && compare(heap[best], heap[left]))
+            best = left;
+        if (right < count && compare(heap[best], heap[right]))
+            best = right;
+        if (best == pos)
+            break;
+
+        swapEntries(pos, best);
+        pos = best;
+    }
+}
+
+inline void OpenList::push(Node* node, int cell)
+{
+    heap.push_back(node);
+    heapCells.push_back(cell);
+    heapIndex[cell] = (int)heap.size() - 1;
+    siftUp((int)heap.size() - 1);
+}
+
+inline Node* OpenList::pop()
+{
+    Node* best = heap.front();
+    int last = (int)heap.size() - 1;
+
+    swapEntries(0, last);
+    heapIndex[heapCells[last]] = -1;
+    heap.pop_back();
+    heapCells.pop_back();
+
+    if (!heap.empty())
+        siftDown(0);
+
+    return best;
+}
+
+inline void OpenList::decreaseKey(int cell)
+{
+    siftUp(heapIndex[cell]);
+}
+
+inline void OpenList::clear()
+{
+    for (int i = 0; i < (int)heap.size(); i++)
+    {
+        heapIndex[heapCells[i]] = -1;
+    }
+    heap.clear();
+    heapCells.clear();
+}
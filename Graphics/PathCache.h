@@ -0,0 +1,131 @@
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <cstdint>
+
+/**
+ * PathCache class - A* results of one team, valid while the team's safety map stays the same
+ * A stored path answers every request from one of its cells to its goal: the rest of an optimal
+ * path is itself an optimal path, so a unit that walked part of the way still finds its route.
+ * Occupied cells only add a soft cost to A*, so paths are reused after units move. Everything is
+ * dropped when the safety map changes (see setEpoch). Searches that found nothing are remembered
+ * too - A* only fails when the terrain cuts the goal off, so they would fail again
+ */
+class PathCache
+{
+public:
+    typedef std::vector<std::pair<int, int>> Path;
+
+private:
+    static const size_t MAX_ENTRIES = 1 << 16; // Indexed cells before the cache starts over
+
+    struct Entry
+    {
+        int path;   // Index in paths
+        int offset; // Cell of the path the entry starts from
+    };
+
+    int rows, cols;
+    unsigned int epoch;                          // Safety map version the paths were found with
+    std::vector<Path> paths;
+    std::unordered_map<uint64_t, Entry> index;   // (cell, goal) -> path passing through cell
+    std::unordered_set<uint64_t> failed;         // (start, goal) searches that found no path
+
+    uint64_t keyOf(int r, int c, int goalRow, int goalCol) const
+    {
+        uint64_t cells = (uint64_t)rows * cols;
+        return ((uint64_t)r * cols + c) * cells + (uint64_t)goalRow * cols + goalCol;
+    }
+
+public:
+    PathCache() : rows(0), cols(0), epoch(0) {}
+
+    /**
+     * Empty cache for a rows x cols map
+     */
+    void reset(int mapRows, int mapCols);
+
+    /**
+     * Safety map version of the team - a new version drops every path
+     */
+    void setEpoch(unsigned int version);
+
+    /**
+     * Cached path from (startRow, startCol) towards (goalRow, goalCol), false if there is none
+     */
+    bool find(int startRow, int startCol, int goalRow, int goalCol, Path& path) const;
+
+    /**
+     * A search from (startRow, startCol) towards (goalRow, goalCol) already found no path
+     */
+    bool hasFailed(int startRow, int startCol, int goalRow, int goalCol) const
+    {
+        return failed.count(keyOf(startRow, startCol, goalRow, goalCol)) != 0;
+    }
+
+    /**
+     * Remember the result of a search from (startRow, startCol) towards (goalRow, goalCol) -
+     * a path (starting at the start cell) or, when empty, the failure
+     */
+    void store(int startRow, int startCol, int goalRow, int goalCol, const Path& path);
+};
+
+// Implementation:
+inline void PathCache::reset(int mapRows, int mapCols)
+{
+    rows = mapRows;
+    cols = mapCols;
+    epoch = 0;
+    paths.clear();
+    index.clear();
+    failed.clear();
+}
+
+inline void PathCache::setEpoch(unsigned int version)
+{
+    if (version == epoch)
+        return;
+
+    epoch = version;
+    paths.clear();
+    index.clear();
+    failed.clear();
+}
+
+inline bool PathCache::find(int startRow, int startCol, int goalRow, int goalCol, Path& path) const
+{
+    auto it = index.find(keyOf(startRow, startCol, goalRow, goalCol));
+    if (it == index.end())
+        return false;
+
+    const Path& stored = paths[it->second.path];
+    path.assign(stored.begin() + it->second.offset, stored.end());
+    return true;
+}
+
+inline void PathCache::store(int startRow, int startCol, int goalRow, int goalCol, const Path& path)
+{
+    if (index.size() + failed.size() + path.size() + 1 > MAX_ENTRIES)
+    {
+        paths.clear();
+        index.clear();
+        failed.clear();
+    }
+
+    if (path.empty())
+    {
+        failed.insert(keyOf(startRow, startCol, goalRow, goalCol));
+        return;
+    }
+
+    int pathNumber = (int)paths.size();
+    paths.push_back(path);
+
+    for (int i = 0; i < (int)path.size(); i++)
+    {
+        Entry entry = { pathNumber, i };
+        index.insert(std::make_pair(keyOf(path[i].first, path[i].second, goalRow, goalCol), entry)); // Keeps older entries
+    }
+}
@@ -1,7 +1,19 @@
 #pragma once
 
+/**
+ * Projectile structure for visual effects
+ */
+struct Projectile
+{
+    double startRow, startCol;     // Starting position
+    double endRow, endCol;         // Target position
+    double currentRow, currentCol; // Current position (animated)
+    int team;                      // Team color
+    bool isGrenade;                // true = grenade, false = bullet
+    int framesAlive;               // How long it's been flying
+    bool active;                   // Still animating
+};
+
 // External function to add visual projectiles
-// Implemented in main.cpp
+// Implemented in Simulation.cpp - forwards to the simulation currently being stepped
 extern void AddProjectile(double startRow, double startCol, double endRow, double endCol, int team, bool isGrenade);
-
-
@@ -0,0 +1,68 @@
+#pragma once
+#include <cstdint>
+
+/**
+ * Random class - Seeded xoshiro256** generator, one per Simulation
+ * The whole match (terrain and combat rolls) draws from it, so a 64-bit seed fully determines a
+ * match and simulations on different threads never share generator state.
+ * The seed is expanded into the 256-bit state with SplitMix64, as recommended by the xoshiro authors
+ */
+class Random
+{
+private:
+    uint64_t state[4];
+
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+public:
+    explicit Random(uint64_t seedValue = 0) { seed(seedValue); }
+
+    /**
+     * Restart the sequence from a seed
+     */
+    void seed(uint64_t seedValue);
+
+    /**
+     * Next 64 random bits
+     */
+    uint64_t next();
+
+    /**
+     * Uniform integer in [0, bound) - bound must be positive
+     */
+    int nextInt(int bound) { return (int)(((next() >> 32) * (uint64_t)bound) >> 32); }
+};
+
+/**
+ * SplitMix64 step - advances x and returns the next mixed value (also used to derive per-match seeds)
+ */
+inline uint64_t SplitMix64(uint64_t& x)
+{
+    uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Implementation:
+inline void Random::seed(uint64_t seedValue)
+{
+    uint64_t x = seedValue;
+    for (int i = 0; i < 4; i++)
+        state[i] = SplitMix64(x);
+}
+
+inline uint64_t Random::next()
+{
+    uint64_t result = rotl(state[1] * 5, 7) * 9;
+    uint64_t t = state[1] << 17;
+
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= t;
+    state[3] = rotl(state[3], 45);
+
+    return result;
+}
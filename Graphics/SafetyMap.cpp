@@ -0,0 +1,78 @@
+#include "SafetyMap.h"
+#include "GridDims.h"
+#include <cstdlib>
+#include <algorithm>
+
+using namespace std;
+
+SafetyMap::SafetyMap()
+{
+    version = 0;
+}
+
+void SafetyMap::reset(int rows, int cols, int numSources)
+{
+    danger.resize(rows, cols, 0);
+    levelCounts.assign((size_t)rows * cols * DANGER_LEVELS, 0);
+
+    DangerSource inactive = { false, -1, -1 };
+    sources.assign(numSources, inactive);
+    version++;
+}
+
+template <typename Dims>
+void SafetyMap::applySourceIn(const Dims& dims, int r, int c, int delta)
+{
+    for (int i = max(0, r - DANGER_RADIUS); i <= min(dims.getRows() - 1, r + DANGER_RADIUS); i++)
+    {
+        for (int j = max(0, c - DANGER_RADIUS); j <= min(dims.getCols() - 1, c + DANGER_RADIUS); j++)
+        {
+            int dist = abs(i - r) + abs(j - c);
+            int level = DANGER_LEVELS - dist; // 1..DANGER_LEVELS, <= 0 means no danger
+            if (level <= 0)
+                continue;
+
+            unsigned short* counts = &levelCounts[(size_t)dims.cellIndex(i, j) * DANGER_LEVELS];
+            counts[level - 1] += delta;
+
+            // Cell value is the highest level that still has a source
+            int top = DANGER_LEVELS;
+            while (top > 0 && counts[top - 1] == 0)
+                top--;
+            dims.at(danger, i, j) = top * DANGER_STEP;
+        }
+    }
+}
+
+struct SafetyMap::SourceUpdate
+{
+    SafetyMap* map;
+    int r, c, delta;
+
+    template <typename Dims>
+    void operator()(const Dims& dims) const { map->applySourceIn(dims, r, c, delta); }
+};
+
+void SafetyMap::applySource(int r, int c, int delta)
+{
+    SourceUpdate update = { this, r, c, delta };
+    DispatchGridDims(danger.getRows(), danger.getCols(), update);
+}
+
+void SafetyMap::setSource(int id, bool active, int r, int c)
+{
+    DangerSource& source = sources[id];
+
+    if (source.active == active && (!active || (source.row == r && source.col == c)))
+        return;
+
+    if (source.active)
+        applySource(source.row, source.col, -1);
+    if (active)
+        applySource(r, c, 1);
+
+    source.active = active;
+    source.row = r;
+    source.col = c;
+    version++;
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include "Definitions.h"
+#include "Grid.h"
+#include <vector>
+
+/**
+ * SafetyMap class - Danger map maintained incrementally from danger sources (visible enemies)
+ * Every cell keeps a count of sources per danger level, so a source that moves or disappears can be
+ * removed again and the cell value is still the max over the remaining sources.
+ * Only sources whose position or visibility changed touch the map
+ */
+class SafetyMap
+{
+private:
+    struct DangerSource
+    {
+        bool active; // Currently contributing danger
+        int row, col;
+    };
+
+    Grid<int> danger;                        // Max danger over all active sources
+    std::vector<unsigned short> levelCounts; // Active sources per cell and danger level (DANGER_LEVELS per cell)
+    std::vector<DangerSource> sources;
+    unsigned int version; // Incremented whenever any cell value changes
+
+    /**
+     * Add (delta = 1) or remove (delta = -1) the danger around (r, c)
+     */
+    void applySource(int r, int c, int delta);
+
+    struct SourceUpdate; // Runs applySourceIn with the dimensions picked by DispatchGridDims
+
+    /**
+     * applySource body, specialized on the map dimensions (see GridDims.h)
+     */
+    template <typename Dims>
+    void applySourceIn(const Dims& dims, int r, int c, int delta);
+
+public:
+    SafetyMap();
+
+    /**
+     * Remove all danger, size the map to rows x cols and the source table for numSources sources
+     */
+    void reset(int rows, int cols, int numSources);
+
+    /**
+     * Update one source - does nothing if neither its visibility nor its position changed
+     */
+    void setSource(int id, bool active, int r, int c);
+
+    int get(int r, int c) const { return danger[r][c]; }
+
+    /**
+     * Danger values as passed to Unit::update
+     */
+    const Grid<int>& values() const { return danger; }
+
+    unsigned int getVersion() const { return version; }
+};
@@ -0,0 +1,112 @@
+#include "Shadowcasting.h"
+#include <cstdlib>
+
+namespace
+{
+    /**
+     * Slope as an exact fraction num / den (den > 0)
+     */
+    struct Slope
+    {
+        int num;
+        int den;
+    };
+
+    int floorDiv(int a, int b)
+    {
+        return (a >= 0) ? a / b : -((-a + b - 1) / b);
+    }
+
+    /**
+     * Scanner for one quadrant - depth is the distance from the origin along the quadrant's axis,
+     * col the offset across it
+     */
+    struct QuadrantScan
+    {
+        const Grid<int>* map;
+        BitGrid* window;
+        int originRow, originCol;
+        int range;
+        int quadrant; // 0 = north, 1 = east, 2 = south, 3 = west
+
+        void toMap(int depth, int col, int& r, int& c) const
+        {
+            switch (quadrant)
+            {
+            case 0: r = originRow - depth; c = originCol + col; break;
+            case 1: r = originRow + col; c = originCol + depth; break;
+            case 2: r = originRow + depth; c = originCol + col; break;
+            default: r = originRow + col; c = originCol - depth; break;
+            }
+        }
+
+        bool isBlocking(int depth, int col) const
+        {
+            int r, c;
+            toMap(depth, col, r, c);
+            if (!map->inBounds(r, c))
+                return true; // Nothing to see past the map edge
+            int cell = (*map)[r][c];
+            return cell == ROCK || cell == TREE;
+        }
+
+        void reveal(int depth, int col)
+        {
+            int r, c;
+            toMap(depth, col, r, c);
+            if (abs(r - originRow) + abs(c - originCol) <= range)
+                window->set(r - originRow + range, c - originCol + range);
+        }
+
+        void scan(int depth, Slope start, Slope end)
+        {
+            if (depth > range)
+                return;
+
+            // Columns whose centers lie between the two slopes (ties rounded toward the inside)
+            int minCol = floorDiv(2 * depth * start.num + start.den, 2 * start.den);
+            int maxCol = -floorDiv(-(2 * depth * end.num - end.den), 2 * end.den);
+
+            bool hasPrev = false;
+            bool prevBlocking = false;
+
+            for (int col = minCol; col <= maxCol; col++)
+            {
+                bool blocking = isBlocking(depth, col);
+
+                // Symmetric: the cell center itself is inside the visible wedge
+                bool symmetric = col * start.den >= depth * start.num && col * end.den <= depth * end.num;
+                if (!blocking && symmetric)
+                    reveal(depth, col);
+
+                if (hasPrev && prevBlocking && !blocking)
+                    start = Slope{ 2 * col - 1, 2 * depth };
+
+                if (hasPrev && !prevBlocking && blocking)
+                    scan(depth + 1, start, Slope{ 2 * col - 1, 2 * depth });
+
+                hasPrev = true;
+                prevBlocking = blocking;
+            }
+
+            if (hasPrev && !prevBlocking)
+                scan(depth + 1, start, end);
+        }
+    };
+}
+
+void ComputeShadowcastFOV(const Grid<int>& map, int originRow, int originCol, int range, BitGrid& window)
+{
+    int windowSize = 2 * range + 1;
+    if (window.getRows() != windowSize || window.getCols() != windowSize)
+        window.resize(windowSize, windowSize);
+
+    window.clear();
+    window.set(range, range);
+
+    for (int quadrant = 0; quadrant < 4; quadrant++)
+    {
+        QuadrantScan quadrantScan = { &map, &window, originRow, originCol, range, quadrant };
+        quadrantScan.scan(1, Slope{ -1, 1 }, Slope{ 1, 1 });
+    }
+}
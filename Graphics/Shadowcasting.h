@@ -0,0 +1,24 @@
+#pragma once
+#include "Definitions.h"
+#include "Grid.h"
+#include "BitGrid.h"
+
+/**
+ * Symmetric shadowcasting field of view
+ * Scans the four quadrants around the origin row by row, tracking the visible slope range,
+ * so every cell within range is looked at once per quadrant instead of once per line that crosses it.
+ *
+ * Follows the same rules as the Bresenham check in LineOfSight::traceLine:
+ * - ROCK and TREE block vision and are never visible themselves (units hiding in trees stay hidden)
+ * - the origin cell never blocks, so a unit inside a tree can still see out
+ * - range is the Manhattan distance VISIBILITY_RANGE
+ * Documented difference: visibility is symmetric (A sees B exactly when B sees A), which Bresenham is not,
+ * so a few floor cells next to obstacle corners can differ between the two engines.
+ *
+ * @param map - map to read obstacles from
+ * @param originRow, originCol - viewer position
+ * @param range - maximum Manhattan distance
+ * @param window - output, the 2 * range + 1 square centred on the origin (window cell (range, range)
+ *                 is the origin); cleared, resized if needed and filled with the visible cells
+ */
+void ComputeShadowcastFOV(const Grid<int>& map, int originRow, int originCol, int range, BitGrid& window);
@@ -0,0 +1,606 @@
+#include "Simulation.h"
+#include "Projectiles.h"
+#include "Commander.h"
+#include "Warrior.h"
+#include "Medic.h"
+#include "Supply.h"
+#include "Log.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cmath>
+
+using namespace std;
+
+// Simulation currently inside step() on this thread - receives AddProjectile calls from units
+static thread_local Simulation* activeSimulation = nullptr;
+
+void AddProjectile(double startRow, double startCol, double endRow, double endCol, int team, bool isGrenade)
+{
+    if (activeSimulation != nullptr)
+        activeSimulation->addProjectile(startRow, startCol, endRow, endCol, team, isGrenade);
+}
+
+Simulation::Simulation()
+{
+    map.resize(MAP_SIZE, MAP_SIZE, SPACE);
+    nextRows = MAP_SIZE;
+    nextCols = MAP_SIZE;
+    roster.warriors = DEFAULT_WARRIORS;
+    roster.medics = DEFAULT_MEDICS;
+    roster.supplies = DEFAULT_SUPPLIES;
+    spawnZoneSize = SPAWN_ZONE_SIZE;
+
+    gameRunning = false;
+    safetyDirty = false;
+    gameOver = false;
+    winningTeam = -1;
+    frameCounter = 0;
+
+    context.lineOfSight = &lineOfSight;
+    context.teamVisibility = teamVisibility;
+    context.occupancy = &occupancy;
+    context.spatial = &spatial;
+    context.store = &store;
+    context.rosters = rosters;
+    context.rng = &rng;
+    pool = nullptr;
+    seed = 0;
+}
+
+Simulation::~Simulation()
+{
+    deleteUnits();
+}
+
+void Simulation::deleteUnits()
+{
+    for (auto unit : allUnits)
+        delete unit;
+    allUnits.clear();
+    store.clear();
+    rosters[TEAM_BLUE].clear();
+    rosters[TEAM_ORANGE].clear();
+    scheduler.clear();
+}
+
+void Simulation::reset(uint64_t matchSeed)
+{
+    seed = matchSeed;
+    rng.seed(matchSeed);
+
+    // Streams of the teams in parallel frames - derived from the seed without drawing from rng
+    uint64_t streamSeed = matchSeed ^ 0xA0761D6478BD642FULL;
+    for (int team = TEAM_BLUE; team <= TEAM_ORANGE; team++)
+    {
+        intents[team].rng.seed(SplitMix64(streamSeed));
+        intents[team].clear();
+    }
+    LOG_INFO(LOG_MATCH, "Match seed " << (unsigned long long)matchSeed);
+
+    gameRunning = true;
+    gameOver = false;
+    winningTeam = -1;
+    frameCounter = 0;
+    activeProjectiles.clear();
+    teamVisibility[TEAM_BLUE].resize(nextRows, nextCols);
+    teamVisibility[TEAM_ORANGE].resize(nextRows, nextCols);
+    occupancy.reset(nextRows, nextCols);
+    spatial.reset(nextRows, nextCols);
+    pathCaches[TEAM_BLUE].reset(nextRows, nextCols);
+    pathCaches[TEAM_ORANGE].reset(nextRows, nextCols);
+
+    // Room for the team plus space to move, but never more than half the map
+    int teamSize = 1 + roster.warriors + roster.medics + roster.supplies;
+    int side = (int)ceil(sqrt(2.0 * teamSize)) + 2;
+    spawnZoneSize = min(max(side, SPAWN_ZONE_SIZE), min(nextRows, nextCols) / 2);
+
+    initMap();
+    lineOfSight.build(map);
+    initUnits();
+
+    safetyMaps[TEAM_BLUE].reset(nextRows, nextCols, (int)allUnits.size());
+    safetyMaps[TEAM_ORANGE].reset(nextRows, nextCols, (int)allUnits.size());
+    safetyDirty = true;
+
+    if (context.telemetry != nullptr)
+    {
+        context.telemetry->setFrame(0);
+        context.telemetry->record(EVENT_MATCH_START, NO_UNIT, NO_TEAM, (int)allUnits.size());
+    }
+}
+
+void Simulation::setMapSize(int rows, int cols)
+{
+    nextRows = max(rows, MIN_MAP_SIZE);
+    nextCols = max(cols, MIN_MAP_SIZE);
+}
+
+void Simulation::setRoster(const Roster& teamRoster)
+{
+    roster.warriors = max(0, teamRoster.warriors);
+    roster.medics = max(0, teamRoster.medics);
+    roster.supplies = max(0, teamRoster.supplies);
+}
+
+void Simulation::setDepotFields(bool enabled)
+{
+    bool wasEnabled = context.medicalFields != nullptr;
+    context.medicalFields = enabled ? medicalFields : nullptr;
+    context.ammoFields = enabled ? ammoFields : nullptr;
+
+    // Switched on during a match - the next reset would be too late
+    if (enabled && !wasEnabled && gameRunning)
+        buildDepotFields();
+}
+
+void Simulation::spawnUnit(Unit* unit)
+{
+    unit->setContext(&context);
+    unit->setId(store.add(unit, unit->getRow(), unit->getCol(), unit->getTeam(), unit->getUnitType(),
+        unit->getMoveFrequency()));
+    occupancy.place(unit->getId(), unit->getRow(), unit->getCol());
+    spatial.insert(unit);
+    rosters[unit->getTeam()].add(unit);
+    scheduler.schedule(unit->getId(), unit->getMoveFrequency()); // First frame that is a multiple of it
+    allUnits.push_back(unit);
+}
+
+void Simulation::initMap()
+{
+    const int rows = nextRows;
+    const int cols = nextCols;
+    map.resize(rows, cols, SPACE);
+
+    // Keep the terrain density of the default battlefield on larger maps
+    const int areaScale = max(1, rows * cols / (MAP_SIZE * MAP_SIZE));
+
+    for (int cluster = 0; cluster < 8 * areaScale; cluster++)
+    {
+        int centerRow = 5 + rng.nextInt(rows - 10);
+        int centerCol = 5 + rng.nextInt(cols - 10);
+        int clusterSize = 2 + rng.nextInt(4);
+
+        for (int i = 0; i < clusterSize; i++)
+        {
+            int r = centerRow + rng.nextInt(5) - 2;
+            int c = centerCol + rng.nextInt(5) - 2;
+            if (map.inBounds(r, c))
+                map[r][c] = ROCK;
+        }
+    }
+
+    for (int cluster = 0; cluster < 10 * areaScale; cluster++)
+    {
+        int centerRow = 5 + rng.nextInt(rows - 10);
+        int centerCol = 5 + rng.nextInt(cols - 10);
+        int clusterSize = 3 + rng.nextInt(5);
+
+        for (int i = 0; i < clusterSize; i++)
+        {
+            int r = centerRow + rng.nextInt(6) - 3;
+            int c = centerCol + rng.nextInt(6) - 3;
+            if (map.inBounds(r, c) && map[r][c] == SPACE)
+                map[r][c] = TREE;
+        }
+    }
+
+    for (int river = 0; river < 3 * areaScale; river++)
+    {
+        int startRow = 10 + rng.nextInt(rows - 20);
+        int startCol = rng.nextInt(cols);
+        int direction = rng.nextInt(2);
+
+        for (int i = 0; i < 15 + rng.nextInt(15); i++)
+        {
+            if (direction == 0)
+            {
+                int c = startCol + i;
+                if (c >= 0 && c < cols && map[startRow][c] == SPACE)
+                    map[startRow][c] = WATER;
+            }
+            else
+            {
+                int r = startRow + i;
+                if (r >= 0 && r < rows && map[r][startCol] == SPACE)
+                    map[r][startCol] = WATER;
+            }
+        }
+    }
+
+    for (int i = 0; i < spawnZoneSize; i++)
+        for (int j = 0; j < spawnZoneSize; j++)
+            map[i][j] = SPACE;
+
+    for (int i = rows - spawnZoneSize; i < rows; i++)
+        for (int j = cols - spawnZoneSize; j < cols; j++)
+            map[i][j] = SPACE;
+
+    map[1][6] = AMMO_DEPOT;
+    map[6][1] = MEDICAL_DEPOT;
+
+    map[rows - 2][cols - 7] = AMMO_DEPOT;
+    map[rows - 7][cols - 2] = MEDICAL_DEPOT;
+
+    // Terrain is final - the depot fields hold for the whole match
+    if (context.medicalFields != nullptr)
+        buildDepotFields();
+}
+
+void Simulation::buildDepotFields()
+{
+    const int rows = map.getRows();
+    const int cols = map.getCols();
+
+    ammoFields[TEAM_BLUE].build(map, 1, 6);
+    medicalFields[TEAM_BLUE].build(map, 6, 1);
+    ammoFields[TEAM_ORANGE].build(map, rows - 2, cols - 7);
+    medicalFields[TEAM_ORANGE].build(map, rows - 7, cols - 2);
+}
+
+void Simulation::initUnits()
+{
+    deleteUnits();
+    spawnTeam(TEAM_BLUE);
+    spawnTeam(TEAM_ORANGE);
+}
+
+void Simulation::spawnTeam(int team)
+{
+    const int rows = map.getRows();
+    const int cols = map.getCols();
+    const int zone = spawnZoneSize;
+
+    // Positions below are in blue's frame, measured from the blue corner
+    int counts[4];
+    counts[COMMANDER] = 1;
+    counts[WARRIOR] = roster.warriors;
+    counts[MEDIC] = roster.medics;
+    counts[SUPPLY] = roster.supplies;
+
+    // Classic slots of the first unit(s) of each type - next to the team's depots
+    const int classicCount[4] = { 1, 2, 1, 1 };
+    const int classicSlots[4][2][2] = {
+        { { 2, 2 }, { -1, -1 } },
+        { { 2, 4 }, { 4, 2 } },
+        { { 6, 2 }, { -1, -1 } },
+        { { 2, 6 }, { -1, -1 } }
+    };
+
+    vector<char> taken(zone * zone, 0);
+    vector<pair<int, int>> slots[4];
+
+    for (int type = COMMANDER; type <= SUPPLY; type++)
+    {
+        for (int i = 0; i < min(counts[type], classicCount[type]); i++)
+        {
+            int r = classicSlots[type][i][0];
+            int c = classicSlots[type][i][1];
+            if (r < zone && c < zone)
+            {
+                taken[r * zone + c] = 1;
+                slots[type].push_back(make_pair(r, c));
+            }
+        }
+    }
+
+    // Everyone else fills the corner ring by ring, nearest the corner first
+    int ring = 0, step = 0;
+    for (int type = COMMANDER; type <= SUPPLY; type++)
+    {
+        while ((int)slots[type].size() < counts[type] && ring < zone)
+        {
+            // Ring d holds (i, d) for i = 0..d and then (d, i) for i = d-1..0
+            int r = (step <= ring) ? step : ring;
+            int c = (step <= ring) ? ring : 2 * ring - step;
+            if (++step > 2 * ring)
+            {
+                ring++;
+                step = 0;
+            }
+
+            int mapRow = (team == TEAM_BLUE) ? r : rows - 1 - r;
+            int mapCol = (team == TEAM_BLUE) ? c : cols - 1 - c;
+            if (taken[r * zone + c] || map[mapRow][mapCol] != SPACE)
+                continue;
+
+            taken[r * zone + c] = 1;
+            slots[type].push_back(make_pair(r, c));
+        }
+
+        if ((int)slots[type].size() < counts[type])
+        {
+            LOG_WARN(LOG_MATCH, "Team " << team << ": spawn zone full, " << counts[type] - (int)slots[type].size()
+                << " units of type " << type << " not spawned");
+        }
+    }
+
+    for (int type = COMMANDER; type <= SUPPLY; type++)
+    {
+        for (const pair<int, int>& slot : slots[type])
+        {
+            int r = (team == TEAM_BLUE) ? slot.first : rows - 1 - slot.first;
+            int c = (team == TEAM_BLUE) ? slot.second : cols - 1 - slot.second;
+
+            switch (type)
+            {
+            case COMMANDER: spawnUnit(new Commander(r, c, team)); break;
+            case WARRIOR: spawnUnit(new Warrior(r, c, team)); break;
+            case MEDIC: spawnUnit(new Medic(r, c, team)); break;
+            case SUPPLY: spawnUnit(new Supply(r, c, team)); break;
+            }
+        }
+    }
+}
+
+void Simulation::updateTeamVisibility()
+{
+    teamVisibility[TEAM_BLUE].clear();
+    teamVisibility[TEAM_ORANGE].clear();
+
+    for (int id = 0; id < store.size(); id++)
+    {
+        if (store.isAlive(id))
+            store.getUnit(id)->orVisibilityInto(teamVisibility[store.getTeam(id)]);
+    }
+}
+
+void Simulation::updateSafetyMap()
+{
+    // A unit is a danger source for the other team when any alive unit of that team sees it
+    for (int id = 0; id < store.size(); id++)
+    {
+        int enemyRow = store.getRow(id);
+        int enemyCol = store.getCol(id);
+        int observerTeam = (store.getTeam(id) == TEAM_BLUE) ? TEAM_ORANGE : TEAM_BLUE;
+
+        bool visible = store.isAlive(id) && teamVisibility[observerTeam].get(enemyRow, enemyCol);
+        safetyMaps[observerTeam].setSource(id, visible, enemyRow, enemyCol);
+    }
+}
+
+void Simulation::checkGameOver()
+{
+    // Kept up to date by the store as units die
+    int blueAlive = store.getAliveCount(TEAM_BLUE);
+    int orangeAlive = store.getAliveCount(TEAM_ORANGE);
+
+    if (blueAlive == 0)
+    {
+        gameOver = true;
+        winningTeam = TEAM_ORANGE;
+        gameRunning = false;
+        if (context.telemetry != nullptr)
+            context.telemetry->record(EVENT_MATCH_END, NO_UNIT, NO_TEAM, winningTeam);
+        LOG_INFO(LOG_MATCH, "=== GAME OVER: TEAM ORANGE WINS! ===");
+    }
+    else if (orangeAlive == 0)
+    {
+        gameOver = true;
+        winningTeam = TEAM_BLUE;
+        gameRunning = false;
+        if (context.telemetry != nullptr)
+            context.telemetry->record(EVENT_MATCH_END, NO_UNIT, NO_TEAM, winningTeam);
+        LOG_INFO(LOG_MATCH, "=== GAME OVER: TEAM BLUE WINS! ===");
+    }
+}
+
+void Simulation::addProjectile(double startRow, double startCol, double endRow, double endCol, int team, bool isGrenade)
+{
+    Projectile proj;
+    proj.startRow = startRow;
+    proj.startCol = startCol;
+    proj.endRow = endRow;
+    proj.endCol = endCol;
+    proj.currentRow = startRow;
+    proj.currentCol = startCol;
+    proj.team = team;
+    proj.isGrenade = isGrenade;
+    proj.framesAlive = 0;
+    proj.active = true;
+
+    // Both teams may be shooting at once - each gets its own list until the frame commits
+    if (context.intents != nullptr)
+        context.intents[team].projectiles.push_back(proj);
+    else
+        activeProjectiles.push_back(proj);
+
+    LOG_DEBUG(LOG_COMBAT, "Created " << (isGrenade ? "GRENADE" : "BULLET") << " from ("
+        << startRow << "," << startCol << ") to (" << endRow << "," << endCol << ")");
+}
+
+void Simulation::updateProjectiles()
+{
+    const double PROJECTILE_SPEED = 0.5; // Cells per frame
+
+    for (auto& proj : activeProjectiles)
+    {
+        if (!proj.active)
+            continue;
+
+        proj.framesAlive++;
+
+        // Move towards target
+        double dx = proj.endCol - proj.currentCol;
+        double dy = proj.endRow - proj.currentRow;
+        double dist = sqrt(dx * dx + dy * dy);
+
+        if (dist < PROJECTILE_SPEED || proj.framesAlive > 60)
+        {
+            // Reached target or timed out
+            proj.active = false;
+        }
+        else
+        {
+            // Move towards target
+            proj.currentCol += (dx / dist) * PROJECTILE_SPEED;
+            proj.currentRow += (dy / dist) * PROJECTILE_SPEED;
+        }
+    }
+
+    // Remove inactive projectiles
+    activeProjectiles.erase(
+        remove_if(activeProjectiles.begin(), activeProjectiles.end(),
+            [](const Projectile& p) { return !p.active; }),
+        activeProjectiles.end()
+    );
+}
+
+void Simulation::step()
+{
+    if (!gameRunning)
+        return;
+
+    advanceTo(frameCounter + 1);
+}
+
+void Simulation::fastForward(int lastFrame)
+{
+    if (!gameRunning || frameCounter >= lastFrame)
+        return;
+
+    // Idle frames only move projectiles, which never touch the match state
+    int frame = scheduler.nextFrame(frameCounter);
+    if (frame == -1 || frame > lastFrame)
+        frame = lastFrame;
+
+    advanceTo(frame);
+}
+
+void Simulation::advanceTo(int frame)
+{
+    activeSimulation = this;
+
+    bool skipped = (frame > frameCounter + 1);
+    frameCounter = frame;
+    if (context.telemetry != nullptr)
+        context.telemetry->setFrame(frameCounter);
+
+    // Update projectile animations - after a jump every shot has already landed
+    if (skipped)
+        activeProjectiles.clear();
+    else
+        updateProjectiles();
+
+    // Positions, health and visibility only change inside Unit::update, so the
+    // safety map needs work only after a frame in which some unit acted
+    if (safetyDirty)
+    {
+        updateTeamVisibility();
+        updateSafetyMap();
+        safetyDirty = false;
+
+        // Paths found under the old danger values no longer apply
+        pathCaches[TEAM_BLUE].setEpoch(safetyMaps[TEAM_BLUE].getVersion());
+        pathCaches[TEAM_ORANGE].setEpoch(safetyMaps[TEAM_ORANGE].getVersion());
+    }
+
+    // Each unit moves at its own frequency - the scheduler hands out only the units due now, in id order
+    scheduler.popDue(frameCounter, dueUnits);
+    if (pool != nullptr)
+    {
+        updateTeamsInParallel();
+    }
+    else
+    {
+        for (int id : dueUnits)
+        {
+            if (!store.isAlive(id))
+                continue; // Killed earlier - leaves the wheel
+
+            store.getUnit(id)->update(map, safetyMaps[store.getTeam(id)].values(), allUnits);
+            scheduler.schedule(id, frameCounter + store.getMoveFrequency(id));
+            safetyDirty = true;
+        }
+    }
+
+    checkGameOver();
+
+    activeSimulation = nullptr;
+}
+
+void Simulation::updateTeamsInParallel()
+{
+    teamDue[TEAM_BLUE].clear();
+    teamDue[TEAM_ORANGE].clear();
+
+    for (int id : dueUnits)
+    {
+        if (!store.isAlive(id))
+            continue;
+
+        teamDue[store.getTeam(id)].push_back(id);
+        scheduler.schedule(id, frameCounter + store.getMoveFrequency(id));
+
+        // Where units start looking from - other origins are computed on the side while frozen
+        lineOfSight.prepare(store.getRow(id), store.getCol(id));
+    }
+
+    if (teamDue[TEAM_BLUE].empty() && teamDue[TEAM_ORANGE].empty())
+        return;
+
+    context.intents = intents;
+    lineOfSight.setFrozen(true);
+    pool->submit([this]() { updateTeam(TEAM_ORANGE); });
+    updateTeam(TEAM_BLUE);
+    pool->waitAll();
+    lineOfSight.setFrozen(false);
+    context.intents = nullptr;
+
+    commitIntents();
+    safetyDirty = true;
+}
+
+void Simulation::updateTeam(int team)
+{
+    Simulation* previous = activeSimulation;
+    activeSimulation = this;
+
+    for (int id : teamDue[team])
+        store.getUnit(id)->update(map, safetyMaps[team].values(), allUnits);
+
+    activeSimulation = previous;
+}
+
+void Simulation::commitIntents()
+{
+    // Units moved on locally during the frame - put them back where the world still has them
+    for (int team = TEAM_BLUE; team <= TEAM_ORANGE; team++)
+    {
+        for (const TeamIntents::Move& move : intents[team].moves)
+            store.getUnit(move.unit)->rollbackMove();
+    }
+
+    // Blue spawns first, so walking blue's intents and then orange's is unit id order
+    for (int team = TEAM_BLUE; team <= TEAM_ORANGE; team++)
+    {
+        if (context.telemetry != nullptr)
+        {
+            for (const TelemetryEvent& event : intents[team].events)
+                context.telemetry->record(event.kind, event.unit, event.team, event.a, event.b, event.c, event.d);
+        }
+        activeProjectiles.insert(activeProjectiles.end(), intents[team].projectiles.begin(), intents[team].projectiles.end());
+    }
+
+    // Shots were aimed at where the targets stood, so they land before anyone moves
+    for (int team = TEAM_BLUE; team <= TEAM_ORANGE; team++)
+    {
+        for (const TeamIntents::Damage& hit : intents[team].damage)
+        {
+            Unit* target = store.getUnit(hit.target);
+            if (target->isAlive())
+                target->takeDamage(hit.amount);
+        }
+    }
+
+    // A move into a cell that is taken by then - by an earlier move or by a unit that stayed - is dropped
+    for (int team = TEAM_BLUE; team <= TEAM_ORANGE; team++)
+    {
+        for (const TeamIntents::Move& move : intents[team].moves)
+        {
+            Unit* unit = store.getUnit(move.unit);
+            if (unit->isAlive() && occupancy.countAt(move.row, move.col) == 0)
+                unit->setPosition(move.row, move.col);
+        }
+        intents[team].clear();
+    }
+}
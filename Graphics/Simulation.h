@@ -0,0 +1,244 @@
+#pragma once
+#include "Definitions.h"
+#include "Unit.h"
+#include "MatchContext.h"
+#include "LineOfSight.h"
+#include "BitGrid.h"
+#include "Grid.h"
+#include "SafetyMap.h"
+#include "OccupancyGrid.h"
+#include "SpatialIndex.h"
+#include "UnitStore.h"
+#include "TeamRoster.h"
+#include "UnitScheduler.h"
+#include "TeamIntents.h"
+#include "PathCache.h"
+#include "DepotField.h"
+#include "Projectiles.h"
+#include "Telemetry.h"
+#include "Random.h"
+#include "ThreadPool.h"
+#include <vector>
+#include <cstdint>
+
+/**
+ * Roster structure - Units each team fields besides its Commander
+ */
+struct Roster
+{
+    int warriors;
+    int medics;
+    int supplies;
+};
+
+/**
+ * Simulation class - Owns the battlefield, the units and the game loop state
+ * Has no rendering dependency: the OpenGL viewer and the headless runner both drive it through step()
+ */
+class Simulation
+{
+private:
+    Grid<int> map;
+    int nextRows, nextCols;  // Battlefield size of the next match (applied by reset)
+    Roster roster;           // Units per team of the following matches
+    int spawnZoneSize;       // Side of the cleared square each team spawns in
+    SafetyMap safetyMaps[2]; // Danger as seen by each team: its visible enemies only
+    bool safetyDirty;        // Some unit acted since the safety maps were last updated
+    std::vector<Unit*> allUnits; // Unit objects in id order - what unit behaviour code iterates
+    UnitStore store;             // Hot state of the same units as arrays - what the frame loop scans
+    TeamRoster rosters[2];       // The same units again per team and role - what role lookups iterate
+    std::vector<Projectile> activeProjectiles;
+    bool gameRunning;
+    bool gameOver;
+    int winningTeam;
+    int frameCounter; // GLOBAL frame counter for all units
+    LineOfSight lineOfSight;
+    BitGrid teamVisibility[2]; // Cells seen by any alive unit of each team
+    OccupancyGrid occupancy;
+    SpatialIndex spatial;      // Alive units by area, team and type for range / nearest queries
+    UnitScheduler scheduler;   // Next action frame of every alive unit
+    std::vector<int> dueUnits; // Units acting in the current frame
+    ThreadPool* pool;          // Runs one team while this thread runs the other, null = sequential frames
+    TeamIntents intents[2];    // What each team decided during a parallel frame
+    std::vector<int> teamDue[2]; // Due units of each team in a parallel frame
+    PathCache pathCaches[2];     // A* results of each team under its current safety map
+    DepotField medicalFields[2]; // Steps to each team's medical depot
+    DepotField ammoFields[2];    // Steps to each team's ammo depot
+    Random rng;        // Drives terrain and combat - the seed fully determines a match
+    uint64_t seed;     // Seed of the current match
+    MatchContext context;
+
+    /**
+     * Generate random terrain, clear the team corners and place the depots
+     */
+    void initMap();
+
+    /**
+     * Fill the depot fields of both teams from the current map
+     */
+    void buildDepotFields();
+
+    /**
+     * Delete old units and spawn both teams
+     */
+    void initUnits();
+
+    /**
+     * Spawn one team's roster in its corner - orange mirrors blue through the map center
+     */
+    void spawnTeam(int team);
+
+    /**
+     * Merge the visibility maps of each team's alive units
+     */
+    void updateTeamVisibility();
+
+    /**
+     * Feed every unit's position and visibility to the opposing team's safety map (only changed sources cost anything)
+     */
+    void updateSafetyMap();
+
+    /**
+     * Advance projectile animations and drop finished ones
+     */
+    void updateProjectiles();
+
+    /**
+     * End the match when one team has no units left
+     */
+    void checkGameOver();
+
+    /**
+     * Jump to frame and play it - the frames skipped over must have no unit due
+     */
+    void advanceTo(int frame);
+
+    /**
+     * Parallel frame: both teams update at once against the world as it was, then commitIntents
+     */
+    void updateTeamsInParallel();
+
+    /**
+     * Update the due units of one team, in id order
+     */
+    void updateTeam(int team);
+
+    /**
+     * Apply both teams' intents: telemetry and projectiles, then hits, then moves - each in unit id
+     * order, so a cell wanted by two units goes to the lower id
+     */
+    void commitIntents();
+
+    void deleteUnits();
+
+    /**
+     * Add a freshly created unit to the match
+     */
+    void spawnUnit(Unit* unit);
+
+    // Owns raw unit pointers - not copyable
+    Simulation(const Simulation&) = delete;
+    Simulation& operator=(const Simulation&) = delete;
+
+public:
+    /**
+     * Constructor - creates an empty simulation, call reset() to start a match
+     */
+    Simulation();
+
+    /**
+     * Destructor - deletes all units
+     */
+    ~Simulation();
+
+    /**
+     * Start a new match from a seed: new map, new units, frame counter back to 0
+     * The same seed always replays the same match
+     */
+    void reset(uint64_t matchSeed);
+
+    /**
+     * Battlefield size of the following matches - takes effect at the next reset()
+     * Sizes below MIN_MAP_SIZE are raised to it so both team corners and depots fit
+     */
+    void setMapSize(int rows, int cols);
+
+    /**
+     * Units per team of the following matches - takes effect at the next reset()
+     * The first unit of each type keeps its classic position, the rest fill the team corner,
+     * which grows with the roster (units that do not fit on the map are not spawned)
+     */
+    void setRoster(const Roster& teamRoster);
+
+    /**
+     * Advance the match by exactly one frame
+     */
+    void step();
+
+    /**
+     * First frame after the current one in which some unit is due to act (-1 if none) -
+     * every frame before it only animates projectiles
+     */
+    int nextEventFrame() const { return scheduler.nextFrame(frameCounter); }
+
+    /**
+     * Fast-forward: advance straight to the next frame in which a unit acts (or to lastFrame if
+     * that comes first). Projectiles land at once instead of animating; the match plays out exactly
+     * as it would one step() at a time
+     */
+    void fastForward(int lastFrame);
+
+    /**
+     * Register a projectile for the viewer (called by units through AddProjectile)
+     */
+    void addProjectile(double startRow, double startCol, double endRow, double endCol, int team, bool isGrenade);
+
+    /**
+     * Record combat events of the following matches to sink (null stops recording)
+     */
+    void setTelemetry(TelemetrySink* sink) { context.telemetry = sink; }
+
+    /**
+     * Select the visibility engine used to fill the line-of-sight cache (FOV_BRESENHAM or FOV_SHADOWCAST)
+     */
+    void setVisibilityEngine(int fovEngine) { lineOfSight.setEngine(fovEngine); }
+
+    /**
+     * Update the two teams side by side, one of them on workers (null = one unit after another).
+     * Units then see the world as it was when the frame began and draw from per-team random streams,
+     * so matches are reproducible but differ from sequential ones. workers must not be the pool
+     * this simulation itself runs on
+     */
+    void setParallel(ThreadPool* workers) { pool = workers; }
+
+    /**
+     * Reuse A* paths while a team's safety map is unchanged (and repair them when the target moved
+     * one cell) instead of searching every time. Paths then ignore units that moved since they were
+     * found, so matches differ from uncached ones
+     */
+    void setPathCache(bool enabled) { context.pathCaches = enabled ? pathCaches : nullptr; }
+
+    /**
+     * Send medics and supply units to their depots down the depot distance fields instead of
+     * searching the map for the depot and running A* to it. The trips take the safest of the
+     * shortest ways rather than A*'s trade-off, so matches differ from the default ones. The fields
+     * are only built while this is on
+     */
+    void setDepotFields(bool enabled);
+
+    // Getters
+    int getRows() const { return map.getRows(); }
+    int getCols() const { return map.getCols(); }
+    int getCell(int r, int c) const { return map[r][c]; }
+    int getUnitAt(int r, int c) const { return occupancy.get(r, c); }
+    int getDanger(int team, int r, int c) const { return safetyMaps[team].get(r, c); }
+    unsigned int getSafetyVersion(int team) const { return safetyMaps[team].getVersion(); }
+    const BitGrid& getTeamVisibility(int team) const { return teamVisibility[team]; }
+    const std::vector<Unit*>& getUnits() const { return allUnits; }
+    const std::vector<Projectile>& getProjectiles() const { return activeProjectiles; }
+    bool isRunning() const { return gameRunning; }
+    bool isGameOver() const { return gameOver; }
+    int getWinningTeam() const { return winningTeam; }
+    int getFrameCounter() const { return frameCounter; }
+    uint64_t getSeed() const { return seed; }
+};
@@ -0,0 +1,190 @@
+#pragma once
+#include "Definitions.h"
+#include "Unit.h"
+#include <vector>
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+
+/**
+ * SpatialIndex class - Alive units bucketed by position, team and type
+ * The map is cut into BUCKET_SIZE x BUCKET_SIZE squares and every square keeps one list per team
+ * and unit type, so range and nearest-unit queries only visit the squares around the origin
+ * instead of the whole unit list. Kept up to date by Unit::setPosition and Unit::takeDamage
+ */
+class SpatialIndex
+{
+private:
+    static const int BUCKET_SIZE = 8;
+    static const int LISTS_PER_BUCKET = 2 * 4; // Team x unit type
+
+    int bucketRows, bucketCols;
+    std::vector<std::vector<Unit*>> lists; // (bucket, team, type) -> units inside
+    std::vector<int> slot;                 // Unit id -> position in its list
+
+    std::vector<Unit*>& listOf(int r, int c, int team, int type)
+    {
+        return lists[((r / BUCKET_SIZE) * bucketCols + c / BUCKET_SIZE) * LISTS_PER_BUCKET + team * 4 + type];
+    }
+
+    const std::vector<Unit*>& listAt(int bucketRow, int bucketCol, int team, int type) const
+    {
+        return lists[(bucketRow * bucketCols + bucketCol) * LISTS_PER_BUCKET + team * 4 + type];
+    }
+
+public:
+    SpatialIndex() : bucketRows(0), bucketCols(0) {}
+
+    /**
+     * Empty index for a rows x cols map
+     */
+    void reset(int rows, int cols);
+
+    /**
+     * Add an alive unit at its current position
+     */
+    void insert(Unit* unit);
+
+    /**
+     * Unit is about to move from its current position to (toRow, toCol)
+     */
+    void move(Unit* unit, int toRow, int toCol);
+
+    /**
+     * Unit left the match (died) at its current position
+     */
+    void remove(Unit* unit);
+
+    /**
+     * Units of team within Manhattan distance range of (row, col), in unit id order
+     */
+    void queryWithinRange(int row, int col, int range, int team, std::vector<Unit*>& result) const;
+
+    /**
+     * Nearest unit (Manhattan) of team and type (or ANY_UNIT_TYPE) for which pred(unit) is true,
+     * the lowest id on ties - null if there is none
+     */
+    template <typename Predicate>
+    Unit* nearest(int row, int col, int team, int type, Predicate pred) const;
+};
+
+// Implementation:
+inline void SpatialIndex::reset(int rows, int cols)
+{
+    bucketRows = (rows + BUCKET_SIZE - 1) / BUCKET_SIZE;
+    bucketCols = (cols + BUCKET_SIZE - 1) / BUCKET_SIZE;
+    lists.assign((size_t)bucketRows * bucketCols * LISTS_PER_BUCKET, std::vector<Unit*>());
+    slot.clear();
+}
+
+inline void SpatialIndex::insert(Unit* unit)
+{
+    std::vector<Unit*>& list = listOf(unit->getRow(), unit->getCol(), unit->getTeam(), unit->getUnitType());
+    if ((int)slot.size() <= unit->getId())
+        slot.resize(unit->getId() + 1, -1);
+    slot[unit->getId()] = (int)list.size();
+    list.push_back(unit);
+}
+
+inline void SpatialIndex::remove(Unit* unit)
+{
+    std::vector<Unit*>& list = listOf(unit->getRow(), unit->getCol(), unit->getTeam(), unit->getUnitType());
+    int index = slot[unit->getId()];
+
+    // Swap with the last entry - queries sort by id, so list order does not matter
+    list[index] = list.back();
+    slot[list[index]->getId()] = index;
+    list.pop_back();
+    slot[unit->getId()] = -1;
+}
+
+inline void SpatialIndex::move(Unit* unit, int toRow, int toCol)
+{
+    if (unit->getRow() / BUCKET_SIZE == toRow / BUCKET_SIZE && unit->getCol() / BUCKET_SIZE == toCol / BUCKET_SIZE)
+        return; // Same bucket
+
+    remove(unit);
+    std::vector<Unit*>& list = listOf(toRow, toCol, unit->getTeam(), unit->getUnitType());
+    slot[unit->getId()] = (int)list.size();
+    list.push_back(unit);
+}
+
+inline void SpatialIndex::queryWithinRange(int row, int col, int range, int team, std::vector<Unit*>& result) const
+{
+    result.clear();
+
+    int firstRow = std::max(0, (row - range) / BUCKET_SIZE);
+    int lastRow = std::min(bucketRows - 1, (row + range) / BUCKET_SIZE);
+    int firstCol = std::max(0, (col - range) / BUCKET_SIZE);
+    int lastCol = std::min(bucketCols - 1, (col + range) / BUCKET_SIZE);
+
+    for (int br = firstRow; br <= lastRow; br++)
+    {
+        for (int bc = firstCol; bc <= lastCol; bc++)
+        {
+            for (int type = 0; type < 4; type++)
+            {
+                for (Unit* unit : listAt(br, bc, team, type))
+                {
+                    if (abs(row - unit->getRow()) + abs(col - unit->getCol()) <= range)
+                        result.push_back(unit);
+                }
+            }
+        }
+    }
+
+    std::sort(result.begin(), result.end(), [](const Unit* a, const Unit* b) { return a->getId() < b->getId(); });
+}
+
+template <typename Predicate>
+inline Unit* SpatialIndex::nearest(int row, int col, int team, int type, Predicate pred) const
+{
+    Unit* best = nullptr;
+    int bestDist = INT_MAX;
+
+    int originRow = row / BUCKET_SIZE;
+    int originCol = col / BUCKET_SIZE;
+    int maxRing = std::max(bucketRows, bucketCols);
+    int firstType = (type == ANY_UNIT_TYPE) ? 0 : type;
+    int lastType = (type == ANY_UNIT_TYPE) ? 3 : type;
+
+    for (int ring = 0; ring <= maxRing; ring++)
+    {
+        // Every cell of ring k is at least (k - 1) * BUCKET_SIZE + 1 away - ties still need a look
+        if (best != nullptr && (ring - 1) * BUCKET_SIZE + 1 > bestDist)
+            break;
+
+        for (int br = originRow - ring; br <= originRow + ring; br++)
+        {
+            if (br < 0 || br >= bucketRows)
+                continue;
+
+            // Full rows at the top and bottom of the ring, only the two sides in between
+            bool edgeRow = (br == originRow - ring || br == originRow + ring);
+            int stepCol = (edgeRow || ring == 0) ? 1 : 2 * ring;
+
+            for (int bc = originCol - ring; bc <= originCol + ring; bc += stepCol)
+            {
+                if (bc < 0 || bc >= bucketCols)
+                    continue;
+
+                for (int t = firstType; t <= lastType; t++)
+                {
+                    for (Unit* unit : listAt(br, bc, team, t))
+                    {
+                        int dist = abs(row - unit->getRow()) + abs(col - unit->getCol());
+                        if (dist > bestDist || (dist == bestDist && unit->getId() > best->getId()))
+                            continue;
+                        if (pred(unit))
+                        {
+                            best = unit;
+                            bestDist = dist;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    return best;
+}
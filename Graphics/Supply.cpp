@@ -1,6 +1,14 @@
 ﻿#include "Supply.h"
 #include "Warrior.h"
-#include <iostream>
+#include "TeamRoster.h"
+#include "DepotField.h"
+#include "Log.h"
+#include "Telemetry.h"
+
+namespace
+{
+    thread_local std::vector<Unit*> neighbours; // Range query results, reused on the thread
+}
 
 Supply::Supply(int startRow, int startCol, int teamId)
     : Unit(startRow, startCol, teamId, SUPPLY, 'P')
@@ -14,8 +22,8 @@ Supply::Supply(int startRow, int startCol, int teamId)
 }
 
 void Supply::update(
-    int map[][MAP_SIZE],
-    int safetyMap[][MAP_SIZE],
+    const Grid<int>& map,
+    const Grid<int>& safetyMap,
     std::vector<Unit*>& allUnits)
 {
     if (!alive)
@@ -37,7 +45,7 @@ void Supply::update(
         pathIndex = 0;
     }
 
-    if (checkTreeHidingLimit(map, allUnits))
+    if (checkTreeHidingLimit(map))
     {
         escapingTree = true;
         currentPath.clear();
@@ -73,8 +81,7 @@ void Supply::update(
 
                 if (isPositionAvailable(map, nextPos.first, nextPos.second, allUnits))
                 {
-                    row = nextPos.first;
-                    col = nextPos.second;
+                    setPosition(nextPos.first, nextPos.second);
                     pathIndex++;
                 }
                 else
@@ -90,8 +97,7 @@ void Supply::update(
 
                         if (isPositionAvailable(map, newRow, newCol, allUnits) && map[newRow][newCol] != TREE)
                         {
-                            row = newRow;
-                            col = newCol;
+                            setPosition(newRow, newCol);
                             currentPath.clear();
                             pathIndex = 0;
                             moved = true;
@@ -119,8 +125,7 @@ void Supply::update(
 
                 if (isPositionAvailable(map, newRow, newCol, allUnits) && map[newRow][newCol] != TREE)
                 {
-                    row = newRow;
-                    col = newCol;
+                    setPosition(newRow, newCol);
                     break;
                 }
             }
@@ -158,8 +163,7 @@ void Supply::update(
                     nextPos = currentPath[pathIndex];
                     if (isPositionAvailable(map, nextPos.first, nextPos.second, allUnits))
                     {
-                        row = nextPos.first;
-                        col = nextPos.second;
+                        setPosition(nextPos.first, nextPos.second);
                         pathIndex++;
                     }
                     else
@@ -173,7 +177,7 @@ void Supply::update(
         else
         {
             int bestRow = row, bestCol = col;
-            int minDanger = (safetyMap != nullptr) ? safetyMap[row][col] : 999;
+            int minDanger = safetyMap[row][col];
 
             int deltaRow[] = { 0, -1, 1, 0 };
             int deltaCol[] = { 1, 0, 0, -1 };
@@ -185,7 +189,7 @@ void Supply::update(
 
                 if (isPositionAvailable(map, newRow, newCol, allUnits))
                 {
-                    int danger = (safetyMap != nullptr) ? safetyMap[newRow][newCol] : 0;
+                    int danger = safetyMap[newRow][newCol];
                     if (danger < minDanger)
                     {
                         minDanger = danger;
@@ -197,8 +201,7 @@ void Supply::update(
 
             if (bestRow != row || bestCol != col)
             {
-                row = bestRow;
-                col = bestCol;
+                setPosition(bestRow, bestCol);
             }
         }
         return;
@@ -206,23 +209,24 @@ void Supply::update(
 
     if (supplyCharges > 0 && !needsRecharge)
     {
-        for (auto unit : allUnits)
+        findUnitsInRange(1, team, allUnits, neighbours);
+        for (auto unit : neighbours)
         {
-            if (unit->getTeam() == team && unit->isAlive() && unit->getUnitType() == WARRIOR)
+            if (unit->getUnitType() == WARRIOR)
             {
-                int dist = abs(row - unit->getRow()) + abs(col - unit->getCol());
-                Warrior* warrior = dynamic_cast<Warrior*>(unit);
-                if (dist <= 1 && warrior && warrior->getAmmo() < MAX_AMMO)
+                Warrior* warrior = static_cast<Warrior*>(unit);
+                if (warrior->getAmmo() < MAX_AMMO)
                 {
-                    std::cout << "Team " << team << " Supply found adjacent warrior needing ammo! Resupplying immediately!" << std::endl;
+                    LOG_INFO(LOG_SUPPORT, "Team " << team << " Supply found adjacent warrior needing ammo! Resupplying immediately!");
                     warrior->refillAmmo(SUPPLY_AMMO_AMOUNT, SUPPLY_GRENADE_AMOUNT);
+                    recordEvent(EVENT_RESUPPLY, warrior->getId(), warrior->getAmmo(), warrior->getGrenades());
                     supplyCharges--;
                     hasOrder = false;
                     currentPath.clear();
                     pathIndex = 0;
                     needsRecharge = true;
-                    std::cout << "Team " << team << " Supply resupplied warrior! Ammo: " << warrior->getAmmo()
-                        << ". Returning to depot." << std::endl;
+                    LOG_INFO(LOG_SUPPORT, "Team " << team << " Supply resupplied warrior! Ammo: " << warrior->getAmmo()
+                        << ". Returning to depot.");
                     return;
                 }
             }
@@ -244,18 +248,18 @@ void Supply::update(
                 if (supplyCharges < MAX_SUPPLY_CHARGES)
                 {
                     supplyCharges = MAX_SUPPLY_CHARGES;
-                    std::cout << ">>> Team " << team << " Supply RECHARGED at depot! Charges: "
-                        << supplyCharges << " <<<" << std::endl;
+                    LOG_INFO(LOG_SUPPORT, ">>> Team " << team << " Supply RECHARGED at depot! Charges: "
+                        << supplyCharges << " <<<");
                 }
 
                 needsRecharge = false;
                 currentPath.clear();
                 pathIndex = 0;
 
-                int currentDanger = (safetyMap != nullptr) ? safetyMap[row][col] : 0;
+                int currentDanger = safetyMap[row][col];
                 if (currentDanger > DANGER_THRESHOLD)
                 {
-                    std::cout << "Team " << team << " Supply at depot detected danger! Escaping..." << std::endl;
+                    LOG_DEBUG(LOG_SUPPORT, "Team " << team << " Supply at depot detected danger! Escaping...");
 
                     int bestRow = row, bestCol = col;
                     int minDanger = currentDanger;
@@ -270,7 +274,7 @@ void Supply::update(
 
                         if (isPositionAvailable(map, newRow, newCol, allUnits))
                         {
-                            int danger = (safetyMap != nullptr) ? safetyMap[newRow][newCol] : 0;
+                            int danger = safetyMap[newRow][newCol];
                             if (danger < minDanger)
                             {
                                 minDanger = danger;
@@ -282,40 +286,42 @@ void Supply::update(
 
                     if (bestRow != row || bestCol != col)
                     {
-                        row = bestRow;
-                        col = bestCol;
+                        setPosition(bestRow, bestCol);
                     }
                     return;
                 }
 
-                for (auto unit : allUnits)
+                for (auto warrior : getTeamRoster(allUnits).getWarriors())
                 {
-                    if (unit->getTeam() == team && unit->isAlive() && unit->getUnitType() == WARRIOR)
+                    if (warrior->getAmmo() < LOW_AMMO)
                     {
-                        Warrior* warrior = dynamic_cast<Warrior*>(unit);
-                        if (warrior && warrior->getAmmo() < LOW_AMMO)
-                        {
-                            std::cout << "Team " << team << " Supply at depot sees warrior at ("
-                                << unit->getRow() << "," << unit->getCol()
-                                << ") needing ammo:" << warrior->getAmmo() << "! Leaving depot!" << std::endl;
-                            hasOrder = true;
-                            targetUnitRow = unit->getRow();
-                            targetUnitCol = unit->getCol();
-                            return;
-                        }
+                        LOG_DEBUG(LOG_SUPPORT, "Team " << team << " Supply at depot sees warrior at ("
+                            << warrior->getRow() << "," << warrior->getCol()
+                            << ") needing ammo:" << warrior->getAmmo() << "! Leaving depot!");
+                        hasOrder = true;
+                        targetUnitRow = warrior->getRow();
+                        targetUnitCol = warrior->getCol();
+                        return;
                     }
                 }
 
                 return;
             }
 
+            // Downhill along the depot field - no search per trip
+            if (context != nullptr && context->ammoFields != nullptr &&
+                descendField(map, safetyMap, context->ammoFields[team], allUnits))
+            {
+                return;
+            }
+
             if (currentPath.empty() || pathIndex >= currentPath.size())
             {
-                static int moveLogCounter = 0;
+                thread_local int moveLogCounter = 0;
                 if (moveLogCounter++ % 60 == 0)
                 {
-                    std::cout << "Team " << team << " Supply at (" << row << "," << col
-                        << ") calculating A* path to depot at (" << ammoDepotRow << "," << ammoDepotCol << ")" << std::endl;
+                    LOG_DEBUG(LOG_SUPPORT, "Team " << team << " Supply at (" << row << "," << col
+                        << ") calculating A* path to depot at (" << ammoDepotRow << "," << ammoDepotCol << ")");
                 }
                 currentPath = findPathAStar(map, safetyMap, ammoDepotRow, ammoDepotCol, allUnits);
                 pathIndex = 0;
@@ -336,8 +342,7 @@ void Supply::update(
                     nextPos = currentPath[pathIndex];
                     if (isPositionAvailable(map, nextPos.first, nextPos.second, allUnits))
                     {
-                        row = nextPos.first;
-                        col = nextPos.second;
+                        setPosition(nextPos.first, nextPos.second);
                         pathIndex++;
                     }
                     else
@@ -355,13 +360,13 @@ void Supply::update(
     }
 
     Warrior* adjacentWarrior = nullptr;
-    for (auto unit : allUnits)
+    findUnitsInRange(1, team, allUnits, neighbours);
+    for (auto unit : neighbours)
     {
-        if (unit->getTeam() == team && unit->isAlive() && unit->getUnitType() == WARRIOR)
+        if (unit->getUnitType() == WARRIOR)
         {
-            int distToUnit = abs(row - unit->getRow()) + abs(col - unit->getCol());
-            Warrior* warrior = dynamic_cast<Warrior*>(unit);
-            if (distToUnit <= 1 && warrior && warrior->getAmmo() < MAX_AMMO)
+            Warrior* warrior = static_cast<Warrior*>(unit);
+            if (warrior->getAmmo() < MAX_AMMO)
             {
                 adjacentWarrior = warrior;
                 break;
@@ -371,12 +376,13 @@ void Supply::update(
 
     if (adjacentWarrior != nullptr)
     {
-        std::cout << "Team " << team << " Supply found adjacent warrior to resupply!" << std::endl;
+        LOG_DEBUG(LOG_SUPPORT, "Team " << team << " Supply found adjacent warrior to resupply!");
         adjacentWarrior->refillAmmo(SUPPLY_AMMO_AMOUNT, SUPPLY_GRENADE_AMOUNT);
+        recordEvent(EVENT_RESUPPLY, adjacentWarrior->getId(), adjacentWarrior->getAmmo(), adjacentWarrior->getGrenades());
         supplyCharges--;
-        std::cout << "Team " << team << " Supply resupplied warrior at ("
+        LOG_INFO(LOG_SUPPORT, "Team " << team << " Supply resupplied warrior at ("
             << adjacentWarrior->getRow() << "," << adjacentWarrior->getCol() << ")! Charges left: "
-            << supplyCharges << std::endl;
+            << supplyCharges);
 
         hasOrder = false;
         currentPath.clear();
@@ -384,23 +390,19 @@ void Supply::update(
         targetUnitRow = targetUnitCol = -1;
         needsRecharge = true;
 
-        std::cout << "Team " << team << " Supply returning to depot to wait for next order!" << std::endl;
+        LOG_DEBUG(LOG_SUPPORT, "Team " << team << " Supply returning to depot to wait for next order!");
         return;
     }
 
     Warrior* targetWarrior = nullptr;
-    for (auto unit : allUnits)
+    for (auto warrior : getTeamRoster(allUnits).getWarriors())
     {
-        if (unit->getTeam() == team && unit->isAlive() && unit->getUnitType() == WARRIOR)
+        if (warrior->getAmmo() < LOW_AMMO)
         {
-            Warrior* warrior = dynamic_cast<Warrior*>(unit);
-            if (warrior && warrior->getAmmo() < LOW_AMMO)
-            {
-                targetWarrior = warrior;
-                targetUnitRow = unit->getRow();
-                targetUnitCol = unit->getCol();
-                break;
-            }
+            targetWarrior = warrior;
+            targetUnitRow = warrior->getRow();
+            targetUnitCol = warrior->getCol();
+            break;
         }
     }
 
@@ -411,7 +413,7 @@ void Supply::update(
         pathIndex = 0;
         targetUnitRow = targetUnitCol = -1;
         needsRecharge = true;
-        std::cout << "Team " << team << " Supply: No warriors needing ammo, returning to depot" << std::endl;
+        LOG_DEBUG(LOG_SUPPORT, "Team " << team << " Supply: No warriors needing ammo, returning to depot");
         return;
     }
 
@@ -436,8 +438,7 @@ void Supply::update(
             nextPos = currentPath[pathIndex];
             if (isPositionAvailable(map, nextPos.first, nextPos.second, allUnits))
             {
-                row = nextPos.first;
-                col = nextPos.second;
+                setPosition(nextPos.first, nextPos.second);
                 pathIndex++;
             }
             else
@@ -460,26 +461,34 @@ void Supply::receiveOrder(int targetRow, int targetCol)
         pathIndex = 0;
         needsRecharge = false;
 
-        std::cout << "Team " << team << " Supply received order to resupply unit at ("
+        LOG_INFO(LOG_SUPPORT, "Team " << team << " Supply received order to resupply unit at ("
             << targetRow << "," << targetCol << "). Charges: " << supplyCharges
-            << " - Leaving depot!" << std::endl;
+            << " - Leaving depot!");
     }
     else
     {
-        std::cout << "Team " << team << " Supply cannot accept order - out of charges!" << std::endl;
+        LOG_INFO(LOG_SUPPORT, "Team " << team << " Supply cannot accept order - out of charges!");
     }
 }
 
-void Supply::findAmmoDepot(int map[][MAP_SIZE])
+void Supply::findAmmoDepot(const Grid<int>& map)
 {
-    int teamStartRow = (team == TEAM_BLUE) ? 0 : MAP_SIZE - 1;
-    int teamStartCol = (team == TEAM_BLUE) ? 0 : MAP_SIZE - 1;
+    // The match already knows where the team's depot is
+    if (context != nullptr && context->ammoFields != nullptr)
+    {
+        ammoDepotRow = context->ammoFields[team].getDepotRow();
+        ammoDepotCol = context->ammoFields[team].getDepotCol();
+        return;
+    }
+
+    int teamStartRow = (team == TEAM_BLUE) ? 0 : map.getRows() - 1;
+    int teamStartCol = (team == TEAM_BLUE) ? 0 : map.getCols() - 1;
 
     int minDistFromStart = 9999;
 
-    for (int i = 0; i < MAP_SIZE; i++)
+    for (int i = 0; i < map.getRows(); i++)
     {
-        for (int j = 0; j < MAP_SIZE; j++)
+        for (int j = 0; j < map.getCols(); j++)
         {
             if (map[i][j] == AMMO_DEPOT)
             {
@@ -497,7 +506,7 @@ void Supply::findAmmoDepot(int map[][MAP_SIZE])
 
     if (ammoDepotRow != -1)
     {
-        std::cout << "Team " << team << " Supply found team depot at ("
-            << ammoDepotRow << "," << ammoDepotCol << ")" << std::endl;
+        LOG_DEBUG(LOG_SUPPORT, "Team " << team << " Supply found team depot at ("
+            << ammoDepotRow << "," << ammoDepotCol << ")");
     }
 }
\ No newline at end of file
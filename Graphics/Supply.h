@@ -30,8 +30,8 @@ public:
      * Update supply behavior
      */
     void update(
-        int map[][MAP_SIZE],
-        int safetyMap[][MAP_SIZE],
+        const Grid<int>& map,
+        const Grid<int>& safetyMap,
         std::vector<Unit*>& allUnits
     ) override;
 
@@ -43,7 +43,7 @@ public:
     /**
      * Find ammo depot location
      */
-    void findAmmoDepot(int map[][MAP_SIZE]);
+    void findAmmoDepot(const Grid<int>& map);
 
     /**
      * Check if supply has active order
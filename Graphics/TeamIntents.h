@@ -0,0 +1,68 @@
+#pragma once
+#include "Projectiles.h"
+#include "Telemetry.h"
+#include "Random.h"
+#include <vector>
+
+/**
+ * TeamIntents structure - What the units of one team decided during a parallel frame
+ * While the two teams update side by side, units read the world as it was when the frame began and
+ * record what they want to change here instead of changing it. The simulation then applies both
+ * teams' intents in unit id order (see Simulation::commitIntents)
+ */
+struct TeamIntents
+{
+    struct Move
+    {
+        int unit;
+        int row, col;
+    };
+
+    struct Damage
+    {
+        int target;
+        int amount;
+    };
+
+    Random rng;                           // The team's own stream - neither team waits on the other's rolls
+    std::vector<Move> moves;              // At most one per unit: the cell its last step of the frame ended on
+    std::vector<Damage> damage;           // Hits on enemy units, in shooter order
+    std::vector<TelemetryEvent> events;   // Telemetry recorded by the team (frame stamped on commit)
+    std::vector<Projectile> projectiles;  // Shots for the viewer
+
+    /**
+     * Unit wants to end the frame at (r, c)
+     */
+    void move(int unit, int r, int c);
+
+    /**
+     * Forget the previous frame (keeps the generator running)
+     */
+    void clear();
+};
+
+// Implementation:
+inline void TeamIntents::move(int unit, int r, int c)
+{
+    // A team's units update one after another, so only the last entry can be this unit's
+    if (!moves.empty() && moves.back().unit == unit)
+    {
+        moves.back().row = r;
+        moves.back().col = c;
+        return;
+    }
+
+    Move entry;
+    entry.unit = unit;
+    entry.row = r;
+    entry.col = c;
+    moves.push_back(entry);
+}
+
+inline void TeamIntents::clear()
+{
+    moves.clear();
+    damage.clear();
+    events.clear();
+    projectiles.clear();
+}
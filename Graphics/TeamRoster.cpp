@@ -0,0 +1,75 @@
+#include "TeamRoster.h"
+#include "Commander.h"
+#include "Warrior.h"
+#include "Medic.h"
+#include "Supply.h"
+#include <algorithm>
+
+namespace
+{
+    template <typename T>
+    void EraseUnit(std::vector<T*>& list, Unit* unit)
+    {
+        typename std::vector<T*>::iterator it = std::find(list.begin(), list.end(), static_cast<T*>(unit));
+        if (it != list.end())
+            list.erase(it); // Keeps id order
+    }
+}
+
+void TeamRoster::clear()
+{
+    commander = nullptr;
+    warriors.clear();
+    medics.clear();
+    supplies.clear();
+}
+
+void TeamRoster::add(Unit* unit)
+{
+    // The unit type tag says which class the unit is - no dynamic_cast needed
+    switch (unit->getUnitType())
+    {
+    case COMMANDER:
+        commander = static_cast<Commander*>(unit);
+        break;
+    case WARRIOR:
+        warriors.push_back(static_cast<Warrior*>(unit));
+        break;
+    case MEDIC:
+        medics.push_back(static_cast<Medic*>(unit));
+        break;
+    case SUPPLY:
+        supplies.push_back(static_cast<Supply*>(unit));
+        break;
+    }
+}
+
+void TeamRoster::remove(Unit* unit)
+{
+    switch (unit->getUnitType())
+    {
+    case COMMANDER:
+        if (commander == unit)
+            commander = nullptr;
+        break;
+    case WARRIOR:
+        EraseUnit(warriors, unit);
+        break;
+    case MEDIC:
+        EraseUnit(medics, unit);
+        break;
+    case SUPPLY:
+        EraseUnit(supplies, unit);
+        break;
+    }
+}
+
+void TeamRoster::build(const std::vector<Unit*>& allUnits, int team)
+{
+    clear();
+    for (auto unit : allUnits)
+    {
+        if (unit->getTeam() == team && unit->isAlive())
+            add(unit);
+    }
+}
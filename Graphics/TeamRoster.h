@@ -0,0 +1,53 @@
+#pragma once
+#include <vector>
+
+class Unit;
+class Commander;
+class Warrior;
+class Medic;
+class Supply;
+
+/**
+ * TeamRoster class - Alive units of one team, by role
+ * Built when the units spawn and updated when they die, so role lookups ("every warrior",
+ * "a free medic") iterate exactly the units of that role with no type filtering and no RTTI.
+ * Every list is in unit id order
+ */
+class TeamRoster
+{
+private:
+    Commander* commander; // Null once the commander is dead
+    std::vector<Warrior*> warriors;
+    std::vector<Medic*> medics;
+    std::vector<Supply*> supplies;
+
+public:
+    TeamRoster() : commander(nullptr) {}
+
+    /**
+     * Remove all units
+     */
+    void clear();
+
+    /**
+     * Add an alive unit - units must be added in id order
+     */
+    void add(Unit* unit);
+
+    /**
+     * Unit died
+     */
+    void remove(Unit* unit);
+
+    /**
+     * Rebuild from the alive units of team in allUnits
+     */
+    void build(const std::vector<Unit*>& allUnits, int team);
+
+    Commander* getCommander() const { return commander; }
+    const std::vector<Warrior*>& getWarriors() const { return warriors; }
+    const std::vector<Medic*>& getMedics() const { return medics; }
+    const std::vector<Supply*>& getSupplies() const { return supplies; }
+
+    int size() const { return (commander != nullptr ? 1 : 0) + (int)(warriors.size() + medics.size() + supplies.size()); }
+};
@@ -0,0 +1,74 @@
+#define _CRT_SECURE_NO_WARNINGS // fopen (SDL checks turn its deprecation warning into an error)
+#include "Telemetry.h"
+#include <cstring>
+
+const size_t TELEMETRY_BUFFER_EVENTS = 4096; // 64 KB per write
+
+TelemetrySink::TelemetrySink()
+{
+    file = nullptr;
+    frame = 0;
+}
+
+TelemetrySink::~TelemetrySink()
+{
+    close();
+}
+
+bool TelemetrySink::open(const char* path)
+{
+    close();
+
+    file = fopen(path, "wb");
+    if (file == nullptr)
+        return false;
+
+    TelemetryHeader header;
+    memcpy(header.magic, TELEMETRY_MAGIC, sizeof(header.magic));
+    header.version = TELEMETRY_VERSION;
+    header.recordSize = sizeof(TelemetryEvent);
+    header.reserved = 0;
+    fwrite(&header, sizeof(header), 1, file);
+
+    buffer.reserve(TELEMETRY_BUFFER_EVENTS);
+    return true;
+}
+
+void TelemetrySink::close()
+{
+    if (file == nullptr)
+        return;
+
+    flush();
+    fclose(file);
+    file = nullptr;
+}
+
+void TelemetrySink::record(uint8_t kind, int unit, int team, int a, int b, int c, int d)
+{
+    if (file == nullptr)
+        return;
+
+    TelemetryEvent event;
+    event.frame = frame;
+    event.unit = (int16_t)unit;
+    event.kind = kind;
+    event.team = (int8_t)team;
+    event.a = (int16_t)a;
+    event.b = (int16_t)b;
+    event.c = (int16_t)c;
+    event.d = (int16_t)d;
+    buffer.push_back(event);
+
+    if (buffer.size() >= TELEMETRY_BUFFER_EVENTS)
+        flush();
+}
+
+void TelemetrySink::flush()
+{
+    if (file == nullptr || buffer.empty())
+        return;
+
+    fwrite(buffer.data(), sizeof(TelemetryEvent), buffer.size(), file);
+    buffer.clear();
+}
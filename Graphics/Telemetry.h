@@ -0,0 +1,99 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+/**
+ * Binary combat telemetry
+ * A telemetry file is one TelemetryHeader followed by fixed-size TelemetryEvent records
+ * (little-endian, no padding). Several matches can share a file - each starts with EVENT_MATCH_START.
+ * EventDecoder turns a file back into text
+ */
+
+// Event kinds and their payload fields (a, b, c, d)
+const uint8_t EVENT_MATCH_START = 0; // a = number of units
+const uint8_t EVENT_MATCH_END = 1;   // a = winning team
+const uint8_t EVENT_SHOT = 2;        // unit = shooter, a = target id, b = damage, c/d = target row/col
+const uint8_t EVENT_GRENADE = 3;     // unit = thrower, a = target id, b = damage, c/d = target row/col
+const uint8_t EVENT_DAMAGE = 4;      // unit = victim, a = damage, b = health left
+const uint8_t EVENT_DEATH = 5;       // unit = victim, a/b = row/col
+const uint8_t EVENT_HEAL = 6;        // unit = medic, a = patient id, b = patient health after
+const uint8_t EVENT_RESUPPLY = 7;    // unit = supply, a = warrior id, b = ammo after, c = grenades after
+const int EVENT_KIND_COUNT = 8;
+
+const char TELEMETRY_MAGIC[4] = { 'C', 'S', 'E', 'V' };
+const uint32_t TELEMETRY_VERSION = 1;
+
+#pragma pack(push, 1)
+struct TelemetryHeader
+{
+    char magic[4];       // TELEMETRY_MAGIC
+    uint32_t version;    // TELEMETRY_VERSION
+    uint32_t recordSize; // sizeof(TelemetryEvent)
+    uint32_t reserved;
+};
+
+struct TelemetryEvent
+{
+    uint32_t frame;        // Simulation frame the event happened in
+    int16_t unit;          // Unit id (Unit::getId), -1 for match events
+    uint8_t kind;          // EVENT_*
+    int8_t team;           // Team of unit, -1 for match events
+    int16_t a, b, c, d;    // Payload, meaning depends on kind
+};
+#pragma pack(pop)
+
+static_assert(sizeof(TelemetryHeader) == 16, "TelemetryHeader layout changed");
+static_assert(sizeof(TelemetryEvent) == 16, "TelemetryEvent layout changed");
+
+/**
+ * Name of an event kind, "?" for unknown kinds
+ */
+inline const char* EventKindName(int kind)
+{
+    static const char* const names[EVENT_KIND_COUNT] =
+        { "match_start", "match_end", "shot", "grenade", "damage", "death", "heal", "resupply" };
+    return (kind >= 0 && kind < EVENT_KIND_COUNT) ? names[kind] : "?";
+}
+
+/**
+ * TelemetrySink class - Buffers events in memory and writes them to a file in large blocks
+ */
+class TelemetrySink
+{
+private:
+    FILE* file;
+    std::vector<TelemetryEvent> buffer; // Events not written yet
+    uint32_t frame;                     // Frame stamped on new events
+
+public:
+    TelemetrySink();
+    ~TelemetrySink();
+
+    /**
+     * Create (truncate) a telemetry file and write its header, false if it cannot be opened
+     */
+    bool open(const char* path);
+
+    /**
+     * Write the remaining events and close the file
+     */
+    void close();
+
+    bool isOpen() const { return file != nullptr; }
+
+    /**
+     * Frame number for the events recorded from now on
+     */
+    void setFrame(int currentFrame) { frame = (uint32_t)currentFrame; }
+
+    /**
+     * Append one event (written once the buffer is full)
+     */
+    void record(uint8_t kind, int unit, int team, int a = 0, int b = 0, int c = 0, int d = 0);
+
+    /**
+     * Write all buffered events to the file
+     */
+    void flush();
+};
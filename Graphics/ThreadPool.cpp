@@ -0,0 +1,124 @@
+#include "ThreadPool.h"
+
+using namespace std;
+
+namespace
+{
+    thread_local int workerIndex = -1;
+}
+
+ThreadPool::ThreadPool(int numThreads)
+    : pending(0), queued(0), nextQueue(0), stopping(false)
+{
+    if (numThreads <= 0)
+        numThreads = (int)thread::hardware_concurrency();
+    if (numThreads <= 0)
+        numThreads = 1;
+
+    for (int i = 0; i < numThreads; i++)
+        queues.push_back(unique_ptr<WorkQueue>(new WorkQueue()));
+
+    for (int i = 0; i < numThreads; i++)
+        workers.push_back(thread(&ThreadPool::run, this, i));
+}
+
+ThreadPool::~ThreadPool()
+{
+    waitAll();
+
+    {
+        lock_guard<mutex> guard(stateLock);
+        stopping = true;
+    }
+    workReady.notify_all();
+
+    for (auto& worker : workers)
+        worker.join();
+}
+
+int ThreadPool::currentWorker()
+{
+    return workerIndex;
+}
+
+void ThreadPool::submit(Task task)
+{
+    int target = workerIndex;
+    if (target < 0)
+        target = (int)(nextQueue.fetch_add(1, memory_order_relaxed) % queues.size());
+
+    pending.fetch_add(1, memory_order_relaxed);
+    {
+        lock_guard<mutex> guard(queues[target]->lock);
+        queues[target]->tasks.push_back(move(task));
+    }
+
+    // Publish under stateLock so a worker deciding to sleep cannot miss it
+    {
+        lock_guard<mutex> guard(stateLock);
+        queued.fetch_add(1, memory_order_release);
+    }
+    workReady.notify_one();
+}
+
+void ThreadPool::waitAll()
+{
+    unique_lock<mutex> guard(stateLock);
+    allDone.wait(guard, [this] { return pending.load(memory_order_acquire) == 0; });
+}
+
+bool ThreadPool::popLocal(int worker, Task& task)
+{
+    WorkQueue& queue = *queues[worker];
+    lock_guard<mutex> guard(queue.lock);
+    if (queue.tasks.empty())
+        return false;
+
+    task = move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool ThreadPool::steal(int worker, Task& task)
+{
+    int count = (int)queues.size();
+    for (int offset = 1; offset < count; offset++)
+    {
+        WorkQueue& victim = *queues[(worker + offset) % count];
+        lock_guard<mutex> guard(victim.lock);
+        if (victim.tasks.empty())
+            continue;
+
+        task = move(victim.tasks.front());
+        victim.tasks.pop_front();
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::run(int worker)
+{
+    workerIndex = worker;
+
+    while (true)
+    {
+        Task task;
+        if (popLocal(worker, task) || steal(worker, task))
+        {
+            queued.fetch_sub(1, memory_order_relaxed);
+            task();
+
+            if (pending.fetch_sub(1, memory_order_acq_rel) == 1)
+            {
+                lock_guard<mutex> guard(stateLock);
+                allDone.notify_all();
+            }
+            continue;
+        }
+
+        unique_lock<mutex> guard(stateLock);
+        workReady.wait(guard, [this] { return stopping || queued.load(memory_order_acquire) > 0; });
+        if (stopping && queued.load(memory_order_acquire) == 0)
+            return;
+    }
+}
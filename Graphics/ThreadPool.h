@@ -0,0 +1,73 @@
+#pragma once
+#include <vector>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <memory>
+
+/**
+ * ThreadPool class - Fixed set of worker threads with work stealing
+ * Every worker has its own task deque. A worker takes its newest task first (back of its deque)
+ * and, when it runs dry, steals the oldest task of another worker (front of their deque), so
+ * uneven tasks - matches of very different lengths - still keep every core busy
+ */
+class ThreadPool
+{
+public:
+    typedef std::function<void()> Task;
+
+    /**
+     * Start numThreads workers (0 = one per hardware thread)
+     */
+    explicit ThreadPool(int numThreads = 0);
+
+    /**
+     * Finish the queued tasks and join the workers
+     */
+    ~ThreadPool();
+
+    int size() const { return (int)workers.size(); }
+
+    /**
+     * Queue a task. From a worker it goes to that worker's deque, otherwise deques take turns
+     */
+    void submit(Task task);
+
+    /**
+     * Block until every submitted task has finished
+     */
+    void waitAll();
+
+    /**
+     * Index of the pool worker running the calling thread, -1 outside the pool
+     */
+    static int currentWorker();
+
+private:
+    struct WorkQueue
+    {
+        std::mutex lock;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::thread> workers;
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+
+    std::mutex stateLock;                // Guards sleeping / waking and the stop flag
+    std::condition_variable workReady;   // Signalled when a task is queued or the pool stops
+    std::condition_variable allDone;     // Signalled when pending drops to 0
+    std::atomic<int> pending;            // Submitted but not finished
+    std::atomic<int> queued;             // Sitting in a deque
+    std::atomic<unsigned int> nextQueue; // Round-robin target for submits from outside the pool
+    bool stopping;
+
+    bool popLocal(int worker, Task& task);
+    bool steal(int worker, Task& task);
+    void run(int worker);
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+};
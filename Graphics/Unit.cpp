@@ -1,20 +1,71 @@
 #include "Unit.h"
-#include "glut.h"
-#include "CompareNodes.h"
-#include <queue>
+#include "OpenList.h"
+#include "CellMarks.h"
+#include "NodePool.h"
+#include "LineOfSight.h"
+#include "OccupancyGrid.h"
+#include "SpatialIndex.h"
+#include "UnitStore.h"
+#include "TeamRoster.h"
+#include "TeamIntents.h"
+#include "PathCache.h"
+#include "DepotField.h"
+#include "Telemetry.h"
+#include "Random.h"
+#include "GridDims.h"
+#include "Log.h"
 #include <vector>
+#include <algorithm>
 #include <cmath>
-#include <iostream>
+#include <cstdlib>
+
+namespace
+{
+    /**
+     * Per-thread search buffers - reused by every A* / BFS search on the thread so searches do not allocate
+     */
+    struct SearchScratch
+    {
+        NodePool nodePool;            // Every node of the current search, released wholesale when it ends
+        OpenList openList;
+        CellMarks closedSet;          // A* closed set
+        CellMarks visited;            // BFS visited set
+        std::vector<double> bestG;    // Best known G per cell (valid while cell is open)
+        std::vector<Node*> bfsQueue;  // BFS FIFO, consumed from a head index
+    };
+
+    thread_local SearchScratch scratch;
+    thread_local TeamRoster standaloneRosters[2]; // Built on demand for units without a match, indexed by team
+
+    /**
+     * Unit::isValidMove with the bounds check and cell lookup specialized on the map dimensions
+     */
+    template <typename Dims>
+    inline bool IsWalkable(const Dims& dims, const Grid<int>& map, int r, int c)
+    {
+        if (!dims.inBounds(r, c))
+            return false;
+
+        int cell = dims.at(map, r, c);
+        return cell != ROCK && cell != WATER;
+    }
+}
 
 Unit::Unit(int startRow, int startCol, int teamId, int type, char sym)
 {
+    id = NO_UNIT;
     row = startRow;
     col = startCol;
+    shownRow = startRow;
+    shownCol = startCol;
     team = teamId;
     unitType = type;
     symbol = sym;
     health = MAX_HEALTH;
     alive = true;
+    context = nullptr;
+    visibleTop = 0;
+    visibleRowCount = 0;
     movementCounter = 0;
     escapingTree = false;
     stuckInTreeCounter = 0;  // Initialize escape counter
@@ -51,24 +102,7 @@ Unit::Unit(int startRow, int startCol, int teamId, int type, char sym)
         moveFrequency = 300;
     }
 
-    // Set team color
-    if (team == TEAM_BLUE)
-    {
-        colorR = Colors::BLUE_R;
-        colorG = Colors::BLUE_G;
-        colorB = Colors::BLUE_B;
-    }
-    else
-    {
-        colorR = Colors::ORANGE_R;
-        colorG = Colors::ORANGE_G;
-        colorB = Colors::ORANGE_B;
-    }
-
-    // Initialize visibility map
-    for (int i = 0; i < MAP_SIZE; i++)
-        for (int j = 0; j < MAP_SIZE; j++)
-            visibilityMap[i][j] = false;
+    // Visibility map starts empty (BitGrid constructor clears it)
 }
 
 Unit::~Unit()
@@ -84,9 +118,24 @@ void Unit::takeDamage(int damage)
 {
     health -= damage;
     if (health <= 0)
-    {
         health = 0;
+
+    recordEvent(EVENT_DAMAGE, damage, health);
+
+    if (health == 0 && alive)
+    {
         alive = false;
+        recordEvent(EVENT_DEATH, row, col);
+
+        if (context != nullptr && context->store != nullptr)
+            context->store->markDead(id);
+
+        if (context != nullptr && context->occupancy != nullptr)
+            context->occupancy->vacate(id, row, col);
+        if (context != nullptr && context->spatial != nullptr)
+            context->spatial->remove(this);
+        if (context != nullptr && context->rosters != nullptr)
+            context->rosters[team].remove(this);
     }
 }
 
@@ -97,9 +146,9 @@ void Unit::heal(int amount)
         health = MAX_HEALTH;
 }
 
-bool Unit::isValidMove(int map[][MAP_SIZE], int r, int c) const
+bool Unit::isValidMove(const Grid<int>& map, int r, int c) const
 {
-    if (r < 0 || r >= MAP_SIZE || c < 0 || c >= MAP_SIZE)
+    if (!map.inBounds(r, c))
         return false;
 
     int cell = map[r][c];
@@ -111,8 +160,88 @@ bool Unit::isValidMove(int map[][MAP_SIZE], int r, int c) const
     return true;
 }
 
+int Unit::randomInt(int bound) const
+{
+    if (context != nullptr && context->intents != nullptr)
+        return context->intents[team].rng.nextInt(bound);
+    if (context != nullptr && context->rng != nullptr)
+        return context->rng->nextInt(bound);
+    return rand() % bound;
+}
+
+void Unit::recordEvent(int kind, int a, int b, int c, int d) const
+{
+    if (context == nullptr || context->telemetry == nullptr)
+        return;
+
+    if (context->intents != nullptr)
+    {
+        TelemetryEvent event;
+        event.frame = 0;
+        event.unit = (int16_t)id;
+        event.kind = (uint8_t)kind;
+        event.team = (int8_t)team;
+        event.a = (int16_t)a;
+        event.b = (int16_t)b;
+        event.c = (int16_t)c;
+        event.d = (int16_t)d;
+        context->intents[team].events.push_back(event);
+        return;
+    }
+
+    context->telemetry->record((uint8_t)kind, id, team, a, b, c, d);
+}
+
+void Unit::damageUnit(Unit* target, int damage)
+{
+    if (context != nullptr && context->intents != nullptr)
+    {
+        TeamIntents::Damage hit;
+        hit.target = target->getId();
+        hit.amount = damage;
+        context->intents[team].damage.push_back(hit);
+        return;
+    }
+
+    target->takeDamage(damage);
+}
+
+void Unit::setPosition(int r, int c)
+{
+    // Parallel frame: everyone else keeps seeing the unit where the frame started
+    if (context != nullptr && context->intents != nullptr)
+    {
+        context->intents[team].move(id, r, c);
+        row = r;
+        col = c;
+        return;
+    }
+
+    if (context != nullptr && context->occupancy != nullptr && alive)
+    {
+        context->occupancy->vacate(id, row, col);
+        context->occupancy->place(id, r, c);
+    }
+    if (context != nullptr && context->spatial != nullptr && alive)
+        context->spatial->move(this, r, c);
+    if (context != nullptr && context->store != nullptr)
+        context->store->setPosition(id, r, c);
+
+    row = shownRow = r;
+    col = shownCol = c;
+}
+
 bool Unit::isPositionOccupied(int r, int c, std::vector<Unit*>& allUnits) const
 {
+    if (context != nullptr && context->occupancy != nullptr)
+    {
+        // The grid holds the positions everyone else sees
+        int others = context->occupancy->countAt(r, c);
+        if (alive && shownRow == r && shownCol == c)
+            others--;
+        return others > 0;
+    }
+
     for (auto unit : allUnits)
     {
         if (unit != this && unit->isAlive())
@@ -124,93 +253,135 @@ bool Unit::isPositionOccupied(int r, int c, std::vector<Unit*>& allUnits) const
     return false;
 }
 
-bool Unit::isPositionAvailable(int map[][MAP_SIZE], int r, int c, std::vector<Unit*>& allUnits) const
+void Unit::findUnitsInRange(int range, int ofTeam, std::vector<Unit*>& allUnits, std::vector<Unit*>& result) const
 {
-    return isValidMove(map, r, c) && !isPositionOccupied(r, c, allUnits);
+    if (context != nullptr && context->spatial != nullptr)
+    {
+        context->spatial->queryWithinRange(row, col, range, ofTeam, result);
+        return;
+    }
+
+    result.clear();
+    for (auto unit : allUnits)
+    {
+        if (unit->getTeam() == ofTeam && unit->isAlive() &&
+            abs(row - unit->getRow()) + abs(col - unit->getCol()) <= range)
+            result.push_back(unit);
+    }
 }
 
-bool Unit::canSeePosition(int map[][MAP_SIZE], int targetRow, int targetCol) const
+Unit* Unit::findNearestUnit(int ofTeam, int type, std::vector<Unit*>& allUnits, bool (*accept)(const Unit*)) const
 {
-    // Check if target is within visibility range
-    int distance = abs(row - targetRow) + abs(col - targetCol);
-    if (distance > VISIBILITY_RANGE)
-        return false;
-
-    // Bresenham's line algorithm to check line of sight
-    int x0 = col, y0 = row;
-    int x1 = targetCol, y1 = targetRow;
-
-    int dx = abs(x1 - x0);
-    int dy = abs(y1 - y0);
-    int sx = (x0 < x1) ? 1 : -1;
-    int sy = (y0 < y1) ? 1 : -1;
-    int err = dx - dy;
+    if (context != nullptr && context->spatial != nullptr)
+    {
+        return context->spatial->nearest(row, col, ofTeam, type,
+            [accept](const Unit* unit) { return accept == nullptr || accept(unit); });
+    }
 
-    int x = x0, y = y0;
+    Unit* nearest = nullptr;
+    int minDistance = 9999;
 
-    while (true)
+    for (auto unit : allUnits)
     {
-        // Check if current cell blocks vision
-        if (x != x0 || y != y0) // Skip starting position
-        {
-            if (x >= 0 && x < MAP_SIZE && y >= 0 && y < MAP_SIZE)
-            {
-                int cell = map[y][x];
-                if (cell == ROCK || cell == TREE)
-                    return false; // Vision blocked
-            }
-        }
-
-        if (x == x1 && y == y1)
-            break;
+        if (unit->getTeam() != ofTeam || !unit->isAlive())
+            continue;
+        if (type != ANY_UNIT_TYPE && unit->getUnitType() != type)
+            continue;
 
-        int e2 = 2 * err;
-        if (e2 > -dy)
+        int dist = abs(row - unit->getRow()) + abs(col - unit->getCol());
+        if (dist < minDistance && (accept == nullptr || accept(unit)))
         {
-            err -= dy;
-            x += sx;
-        }
-        if (e2 < dx)
-        {
-            err += dx;
-            y += sy;
+            minDistance = dist;
+            nearest = unit;
         }
     }
+    return nearest;
+}
 
-    return true;
+const TeamRoster& Unit::getTeamRoster(std::vector<Unit*>& allUnits) const
+{
+    return getRoster(team, allUnits);
 }
 
-void Unit::updateVisibilityMap(int map[][MAP_SIZE])
+const TeamRoster& Unit::getRoster(int rosterTeam, std::vector<Unit*>& allUnits) const
 {
-    // Reset visibility map
-    for (int i = 0; i < MAP_SIZE; i++)
-        for (int j = 0; j < MAP_SIZE; j++)
-            visibilityMap[i][j] = false;
+    if (context != nullptr && context->rosters != nullptr)
+        return context->rosters[rosterTeam];
+
+    standaloneRosters[rosterTeam].build(allUnits, rosterTeam);
+    return standaloneRosters[rosterTeam];
+}
 
+bool Unit::isPositionAvailable(const Grid<int>& map, int r, int c, std::vector<Unit*>& allUnits) const
+{
+    return isValidMove(map, r, c) && !isPositionOccupied(r, c, allUnits);
+}
+
+bool Unit::canSeePosition(const Grid<int>& map, int targetRow, int targetCol) const
+{
+    if (context != nullptr && context->lineOfSight != nullptr)
+        return context->lineOfSight->canSee(row, col, targetRow, targetCol);
+
+    return LineOfSight::traceLine(map, row, col, targetRow, targetCol);
+}
+
+void Unit::updateVisibilityMap(const Grid<int>& map)
+{
     if (!alive)
+    {
+        // Reset visibility map
+        visibilityMap.clearRows(visibleTop, visibleRowCount);
+        visibleRowCount = 0;
+        return;
+    }
+
+    if (visibilityMap.getRows() != map.getRows() || visibilityMap.getCols() != map.getCols())
+    {
+        visibilityMap.resize(map.getRows(), map.getCols());
+        visibleRowCount = 0;
+    }
+
+    // Only the rows within VISIBILITY_RANGE of the unit can hold visible cells
+    visibilityMap.clearRows(visibleTop, visibleRowCount);
+    visibleTop = row - VISIBILITY_RANGE;
+    visibleRowCount = 2 * VISIBILITY_RANGE + 1;
+
+    // Terrain is static - merge the cached visibility window of this cell
+    if (context != nullptr && context->lineOfSight != nullptr)
+    {
+        context->lineOfSight->addVisibleFrom(row, col, visibilityMap);
         return;
+    }
 
     // Check all cells within visibility range
-    for (int i = 0; i < MAP_SIZE; i++)
+    for (int i = row - VISIBILITY_RANGE; i <= row + VISIBILITY_RANGE; i++)
     {
-        for (int j = 0; j < MAP_SIZE; j++)
+        for (int j = col - VISIBILITY_RANGE; j <= col + VISIBILITY_RANGE; j++)
         {
-            if (canSeePosition(map, i, j))
-                visibilityMap[i][j] = true;
+            if (map.inBounds(i, j) && LineOfSight::traceLine(map, row, col, i, j))
+                visibilityMap.set(i, j);
         }
     }
 }
 
+void Unit::orVisibilityInto(BitGrid& target) const
+{
+    if (visibleRowCount > 0)
+        target.orRows(visibilityMap, visibleTop, visibleRowCount);
+}
+
 bool Unit::getVisibility(int r, int c) const
 {
-    if (r < 0 || r >= MAP_SIZE || c < 0 || c >= MAP_SIZE)
+    if (r < 0 || r >= visibilityMap.getRows() || c < 0 || c >= visibilityMap.getCols())
         return false;
-    return visibilityMap[r][c];
+    return visibilityMap.get(r, c);
 }
 
-std::vector<std::pair<int, int>> Unit::findPathAStar(
-    int map[][MAP_SIZE],
-    int safetyMap[][MAP_SIZE],
+template <typename Dims>
+std::vector<std::pair<int, int>> Unit::findPathAStarIn(
+    const Dims& dims,
+    const Grid<int>& map,
+    const Grid<int>& safetyMap,
     int targetRow,
     int targetCol,
     std::vector<Unit*>& allUnits)
@@ -218,25 +389,35 @@ std::vector<std::pair<int, int>> Unit::findPathAStar(
     std::vector<std::pair<int, int>> path;
 
     // Check if target is valid
-    if (!isValidMove(map, targetRow, targetCol))
+    if (!IsWalkable(dims, map, targetRow, targetCol))
         return path;
 
-    std::priority_queue<Node*, std::vector<Node*>, CompareNodes> openList;
-    std::vector<Node*> closedList;
+    const int numCells = dims.getCellCount();
+    NodePool& nodePool = scratch.nodePool;
+    OpenList& openList = scratch.openList;
+    CellMarks& closedSet = scratch.closedSet;
+    std::vector<double>& bestG = scratch.bestG;
+
+    // At most one node per cell: a cell gets a node once and is then only updated in place
+    nodePool.reset(numCells);
+    openList.reset(numCells);
+    closedSet.reset(numCells);
+    if ((int)bestG.size() != numCells)
+        bestG.assign(numCells, 0.0);
 
-    Node* startNode = new Node(row, col);
+    Node* startNode = nodePool.create(row, col);
     startNode->calculateHeuristic(targetRow, targetCol);
     startNode->setG(0);
 
-    openList.push(startNode);
+    openList.push(startNode, dims.cellIndex(row, col));
+    bestG[dims.cellIndex(row, col)] = 0;
 
     int deltaRow[] = { 0, -1, 1, 0 };
     int deltaCol[] = { 1, 0, 0, -1 };
 
     while (!openList.empty())
     {
-        Node* current = openList.top();
-        openList.pop();
+        Node* current = openList.pop();
 
         int distToTarget = abs(current->getRow() - targetRow) + abs(current->getCol() - targetCol);
         if (distToTarget <= 1)
@@ -244,30 +425,25 @@ std::vector<std::pair<int, int>> Unit::findPathAStar(
             Node* pathNode = current;
             while (pathNode != nullptr)
             {
-                path.insert(path.begin(), { pathNode->getRow(), pathNode->getCol() });
+                path.push_back({ pathNode->getRow(), pathNode->getCol() });
                 pathNode = pathNode->getParent();
             }
+            std::reverse(path.begin(), path.end());
 
-            delete current;
-            while (!openList.empty())
-            {
-                delete openList.top();
-                openList.pop();
-            }
-            for (auto node : closedList)
-                delete node;
+            openList.clear();
+            nodePool.reset(0);
 
             return path;
         }
 
-        closedList.push_back(current);
+        closedSet.mark(dims.cellIndex(current->getRow(), current->getCol()));
 
         for (int dir = 0; dir < 4; dir++)
         {
             int newRow = current->getRow() + deltaRow[dir];
             int newCol = current->getCol() + deltaCol[dir];
 
-            if (!isValidMove(map, newRow, newCol))
+            if (!IsWalkable(dims, map, newRow, newCol))
                 continue;
 
             double occupiedPenalty = 0;
@@ -276,90 +452,185 @@ std::vector<std::pair<int, int>> Unit::findPathAStar(
                 occupiedPenalty = 50.0;
             }
 
-            bool inClosedList = false;
-            for (auto closedNode : closedList)
-            {
-                if (closedNode->isAt(newRow, newCol))
-                {
-                    inClosedList = true;
-                    break;
-                }
-            }
-            if (inClosedList)
+            int cell = dims.cellIndex(newRow, newCol);
+            if (closedSet.contains(cell))
                 continue;
 
-            Node* neighbor = new Node(current, newRow, newCol);
+            double safetyCost = dims.at(safetyMap, newRow, newCol) / 10.0;
+            double newG = current->getG() + 1 + safetyCost + occupiedPenalty;
 
-            double safetyCost = 0;
-            if (safetyMap != nullptr)
+            // Already open: keep the cheaper route and move the node up the heap in place
+            if (openList.contains(cell))
             {
-                int danger = safetyMap[newRow][newCol];
-                safetyCost = danger / 10.0;
+                if (newG < bestG[cell])
+                {
+                    Node* openNode = openList.get(cell);
+                    openNode->setParent(current);
+                    openNode->setG(newG);
+                    bestG[cell] = newG;
+                    openList.decreaseKey(cell);
+                }
+                continue;
             }
-            neighbor->setG(current->getG() + 1 + safetyCost + occupiedPenalty);
+
+            Node* neighbor = nodePool.create(current, newRow, newCol);
+            neighbor->setG(newG);
             neighbor->calculateHeuristic(targetRow, targetCol);
+            bestG[cell] = newG;
+            openList.push(neighbor, cell);
+        }
+    }
+
+    nodePool.reset(0);
+
+    return path;
+}
+
+struct Unit::PathSearch
+{
+    Unit* unit;
+    const Grid<int>& map;
+    const Grid<int>& safetyMap;
+    int targetRow, targetCol;
+    std::vector<Unit*>& allUnits;
+
+    template <typename Dims>
+    std::vector<std::pair<int, int>> operator()(const Dims& dims) const
+    {
+        return unit->findPathAStarIn(dims, map, safetyMap, targetRow, targetCol, allUnits);
+    }
+};
 
-            bool foundBetter = false;
-            std::vector<Node*> tempList;
+std::vector<std::pair<int, int>> Unit::findPathAStar(
+    const Grid<int>& map,
+    const Grid<int>& safetyMap,
+    int targetRow,
+    int targetCol,
+    std::vector<Unit*>& allUnits)
+{
+    PathCache* cache = (context != nullptr && context->pathCaches != nullptr) ? &context->pathCaches[team] : nullptr;
+
+    std::vector<std::pair<int, int>> path;
+    if (cache != nullptr && findCachedPath(map, *cache, targetRow, targetCol, path))
+        return path;
+    if (cache != nullptr && cache->hasFailed(row, col, targetRow, targetCol))
+        return path;
+
+    PathSearch search = { this, map, safetyMap, targetRow, targetCol, allUnits };
+    path = DispatchGridDims(map.getRows(), map.getCols(), search);
+
+    if (cache != nullptr)
+        cache->store(row, col, targetRow, targetCol, path);
+    return path;
+}
 
-            while (!openList.empty())
+bool Unit::findCachedPath(const Grid<int>& map, PathCache& cache, int targetRow, int targetCol,
+    std::vector<std::pair<int, int>>& path) const
+{
+    // A* answers nothing for a target it cannot stand on
+    if (!isValidMove(map, targetRow, targetCol))
+        return false;
+
+    int deltaRow[] = { 0, -1, 1, 0 };
+    int deltaCol[] = { 1, 0, 0, -1 };
+
+    // The target itself, then the cells it may have stepped from
+    for (int dir = -1; dir < 4; dir++)
+    {
+        int goalRow = (dir < 0) ? targetRow : targetRow + deltaRow[dir];
+        int goalCol = (dir < 0) ? targetCol : targetCol + deltaCol[dir];
+        if (!cache.find(row, col, goalRow, goalCol, path))
+            continue;
+
+        // A* stops at the first cell next to the target - trim there
+        for (size_t i = 0; i < path.size(); i++)
+        {
+            if (abs(path[i].first - targetRow) + abs(path[i].second - targetCol) <= 1)
             {
-                Node* openNode = openList.top();
-                openList.pop();
+                path.resize(i + 1);
+                if (dir >= 0)
+                    cache.store(row, col, targetRow, targetCol, path);
+                return true;
+            }
+        }
 
-                if (openNode->isAt(newRow, newCol))
-                {
-                    if (neighbor->getG() < openNode->getG())
-                    {
-                        delete openNode;
-                        foundBetter = true;
-                    }
-                    else
-                    {
-                        tempList.push_back(openNode);
-                        delete neighbor;
-                        neighbor = nullptr;
-                        foundBetter = true;
-                    }
-                }
-                else
-                {
-                    tempList.push_back(openNode);
-                }
+        // The target stepped away from the end of the path - one more cell reaches it
+        int endRow = path.back().first;
+        int endCol = path.back().second;
+        for (int step = 0; step < 4; step++)
+        {
+            int r = endRow + deltaRow[step];
+            int c = endCol + deltaCol[step];
+            if (abs(r - targetRow) + abs(c - targetCol) <= 1 && isValidMove(map, r, c))
+            {
+                path.push_back(std::make_pair(r, c));
+                cache.store(row, col, targetRow, targetCol, path);
+                return true;
             }
+        }
+    }
+
+    path.clear();
+    return false;
+}
+
+bool Unit::descendField(const Grid<int>& map, const Grid<int>& safetyMap, const DepotField& field,
+    std::vector<Unit*>& allUnits)
+{
+    int steps = field.get(row, col);
+    if (steps < 0)
+        return false;
+    if (steps == 0)
+        return true;
 
-            for (auto node : tempList)
-                openList.push(node);
+    int deltaRow[] = { 0, -1, 1, 0 };
+    int deltaCol[] = { 1, 0, 0, -1 };
+    int bestRow = -1, bestCol = -1;
+    int minDanger = 0;
 
-            if (!foundBetter && neighbor != nullptr)
-                openList.push(neighbor);
-            else if (foundBetter && neighbor != nullptr)
-                openList.push(neighbor);
+    // Every neighbour one step closer lies on a shortest way - take the safest free one
+    for (int dir = 0; dir < 4; dir++)
+    {
+        int newRow = row + deltaRow[dir];
+        int newCol = col + deltaCol[dir];
+        if (field.get(newRow, newCol) != steps - 1 || !isPositionAvailable(map, newRow, newCol, allUnits))
+            continue;
+
+        int danger = safetyMap[newRow][newCol];
+        if (bestRow == -1 || danger < minDanger)
+        {
+            bestRow = newRow;
+            bestCol = newCol;
+            minDanger = danger;
         }
     }
 
-    for (auto node : closedList)
-        delete node;
-
-    return path;
+    if (bestRow != -1)
+        setPosition(bestRow, bestCol);
+    return true;
 }
 
-bool Unit::findNearestCover(int map[][MAP_SIZE], int& coverRow, int& coverCol)
+bool Unit::findNearestCover(const Grid<int>& map, int& coverRow, int& coverCol)
 {
-    std::queue<Node*> bfsQueue;
-    std::vector<std::vector<bool>> visited(MAP_SIZE, std::vector<bool>(MAP_SIZE, false));
-
-    Node* startNode = new Node(row, col);
-    bfsQueue.push(startNode);
-    visited[row][col] = true;
+    NodePool& nodePool = scratch.nodePool;
+    std::vector<Node*>& bfsQueue = scratch.bfsQueue;
+    CellMarks& visited = scratch.visited;
+    const int cols = map.getCols();
+    nodePool.reset(map.getCellCount());
+    bfsQueue.clear();
+    visited.reset(map.getCellCount());
+
+    Node* startNode = nodePool.create(row, col);
+    bfsQueue.push_back(startNode);
+    visited.mark(row * cols + col);
+    size_t queueHead = 0;
 
     int deltaRow[] = { 0, -1, 1, 0 };
     int deltaCol[] = { 1, 0, 0, -1 };
 
-    while (!bfsQueue.empty())
+    while (queueHead < bfsQueue.size())
     {
-        Node* current = bfsQueue.front();
-        bfsQueue.pop();
+        Node* current = bfsQueue[queueHead++];
 
         int r = current->getRow();
         int c = current->getCol();
@@ -369,7 +640,7 @@ bool Unit::findNearestCover(int map[][MAP_SIZE], int& coverRow, int& coverCol)
         {
             int checkRow = r + deltaRow[dir];
             int checkCol = c + deltaCol[dir];
-            if (checkRow >= 0 && checkRow < MAP_SIZE && checkCol >= 0 && checkCol < MAP_SIZE)
+            if (map.inBounds(checkRow, checkCol))
             {
                 if (map[checkRow][checkCol] == ROCK || map[checkRow][checkCol] == TREE)
                 {
@@ -384,42 +655,32 @@ bool Unit::findNearestCover(int map[][MAP_SIZE], int& coverRow, int& coverCol)
             coverRow = r;
             coverCol = c;
 
-            delete current;
-            while (!bfsQueue.empty())
-            {
-                delete bfsQueue.front();
-                bfsQueue.pop();
-            }
-
+            nodePool.reset(0);
             return true;
         }
 
         if (current->getDepth() >= MAX_BFS_DEPTH)
-        {
-            delete current;
             continue;
-        }
 
         for (int dir = 0; dir < 4; dir++)
         {
             int newRow = r + deltaRow[dir];
             int newCol = c + deltaCol[dir];
 
-            if (isValidMove(map, newRow, newCol) && !visited[newRow][newCol])
+            if (isValidMove(map, newRow, newCol) && !visited.contains(newRow * cols + newCol))
             {
-                visited[newRow][newCol] = true;
-                Node* neighbor = new Node(current, newRow, newCol);
-                bfsQueue.push(neighbor);
+                visited.mark(newRow * cols + newCol);
+                Node* neighbor = nodePool.create(current, newRow, newCol);
+                bfsQueue.push_back(neighbor);
             }
         }
-
-        delete current;
     }
 
+    nodePool.reset(0);
     return false;
 }
 
-void Unit::moveTowards(int targetRow, int targetCol, int map[][MAP_SIZE], std::vector<Unit*>& allUnits)
+void Unit::moveTowards(int targetRow, int targetCol, const Grid<int>& map, std::vector<Unit*>& allUnits)
 {
     if (!alive)
         return;
@@ -458,14 +719,13 @@ void Unit::moveTowards(int targetRow, int targetCol, int map[][MAP_SIZE], std::v
 
         if (isPositionAvailable(map, newRow, newCol, allUnits))
         {
-            row = newRow;
-            col = newCol;
+            setPosition(newRow, newCol);
             return;
         }
     }
 }
 
-void Unit::tryUnstuck(int map[][MAP_SIZE], std::vector<Unit*>& allUnits)
+void Unit::tryUnstuck(const Grid<int>& map, std::vector<Unit*>& allUnits)
 {
     int deltaRow[] = { 0, -1, 1, 0 };
     int deltaCol[] = { 1, 0, 0, -1 };
@@ -477,14 +737,13 @@ void Unit::tryUnstuck(int map[][MAP_SIZE], std::vector<Unit*>& allUnits)
 
         if (isPositionAvailable(map, newRow, newCol, allUnits))
         {
-            row = newRow;
-            col = newCol;
+            setPosition(newRow, newCol);
             return;
         }
     }
 }
 
-bool Unit::detectRepeatingPattern(int map[][MAP_SIZE], std::vector<Unit*>& allUnits)
+bool Unit::detectRepeatingPattern(const Grid<int>& map, std::vector<Unit*>& allUnits)
 {
     // If in cooldown after breaking a loop, decrement and don't check for patterns
     if (loopBreakCooldown > 0)
@@ -524,7 +783,7 @@ bool Unit::detectRepeatingPattern(int map[][MAP_SIZE], std::vector<Unit*>& allUn
 
         if (twoPattern && (posHistory[0][0] != posHistory[1][0] || posHistory[0][1] != posHistory[1][1]))
         {
-            std::cout << "Team " << team << " " << symbol << " detected 2-position loop! Breaking..." << std::endl;
+            LOG_DEBUG(LOG_MOVEMENT, "Team " << team << " " << symbol << " detected 2-position loop! Breaking...");
 
             // Move to position NOT in the pattern
             int deltaRow[] = { 0, -1, 1, 0, -1, 1, -1, 1 };
@@ -549,8 +808,7 @@ bool Unit::detectRepeatingPattern(int map[][MAP_SIZE], std::vector<Unit*>& allUn
                 if (!inPattern && isPositionAvailable(map, newRow, newCol, allUnits))
                 {
                     // Move to escape position
-                    row = newRow;
-                    col = newCol;
+                    setPosition(newRow, newCol);
 
                     // Try to move 1-2 more cells in same direction to really get away
                     for (int extra = 0; extra < 2; extra++)
@@ -559,14 +817,13 @@ bool Unit::detectRepeatingPattern(int map[][MAP_SIZE], std::vector<Unit*>& allUn
                         int furtherCol = col + deltaCol[i];
                         if (isPositionAvailable(map, furtherRow, furtherCol, allUnits))
                         {
-                            row = furtherRow;
-                            col = furtherCol;
+                            setPosition(furtherRow, furtherCol);
                         }
                         else
                             break;
                     }
 
-                    std::cout << "Team " << team << " " << symbol << " escaped 2-pos loop to (" << row << "," << col << ")" << std::endl;
+                    LOG_DEBUG(LOG_MOVEMENT, "Team " << team << " " << symbol << " escaped 2-pos loop to (" << row << "," << col << ")");
 
                     // Reset history
                     for (int k = 0; k < 8; k++)
@@ -592,7 +849,7 @@ bool Unit::detectRepeatingPattern(int map[][MAP_SIZE], std::vector<Unit*>& allUn
 
         if (threePattern)
         {
-            std::cout << "Team " << team << " " << symbol << " detected 3-position loop! Breaking..." << std::endl;
+            LOG_DEBUG(LOG_MOVEMENT, "Team " << team << " " << symbol << " detected 3-position loop! Breaking...");
 
             // Move to position NOT in the 3-position pattern
             int deltaRow[] = { 0, -1, 1, 0, -1, 1, -1, 1 };
@@ -616,9 +873,8 @@ bool Unit::detectRepeatingPattern(int map[][MAP_SIZE], std::vector<Unit*>& allUn
 
                 if (!inPattern && isPositionAvailable(map, newRow, newCol, allUnits))
                 {
-                    row = newRow;
-                    col = newCol;
-                    std::cout << "Team " << team << " " << symbol << " escaped 3-pos loop to (" << row << "," << col << ")" << std::endl;
+                    setPosition(newRow, newCol);
+                    LOG_DEBUG(LOG_MOVEMENT, "Team " << team << " " << symbol << " escaped 3-pos loop to (" << row << "," << col << ")");
 
                     // Reset history
                     for (int k = 0; k < 8; k++)
@@ -656,7 +912,7 @@ bool Unit::detectRepeatingPattern(int map[][MAP_SIZE], std::vector<Unit*>& allUn
 
         if (fourPattern)
         {
-            std::cout << "Team " << team << " " << symbol << " detected 4-position loop! Breaking..." << std::endl;
+            LOG_DEBUG(LOG_MOVEMENT, "Team " << team << " " << symbol << " detected 4-position loop! Breaking...");
 
             // Move to position NOT in the 4-position pattern
             int deltaRow[] = { 0, -1, 1, 0, -1, 1, -1, 1 };
@@ -680,9 +936,8 @@ bool Unit::detectRepeatingPattern(int map[][MAP_SIZE], std::vector<Unit*>& allUn
 
                 if (!inPattern && isPositionAvailable(map, newRow, newCol, allUnits))
                 {
-                    row = newRow;
-                    col = newCol;
-                    std::cout << "Team " << team << " " << symbol << " escaped 4-pos loop to (" << row << "," << col << ")" << std::endl;
+                    setPosition(newRow, newCol);
+                    LOG_DEBUG(LOG_MOVEMENT, "Team " << team << " " << symbol << " escaped 4-pos loop to (" << row << "," << col << ")");
 
                     // Reset history
                     for (int k = 0; k < 8; k++)
@@ -713,35 +968,7 @@ bool Unit::detectRepeatingPattern(int map[][MAP_SIZE], std::vector<Unit*>& allUn
     return false;
 }
 
-//// Check if unit is stuck in tree
-//bool Unit::checkTreeHidingLimit(int map[][MAP_SIZE], std::vector<Unit*>& allUnits)
-//{
-//    const int MAX_TREE_FRAMES = 600; // 10 seconds at 60 FPS
-//
-//    // Check if currently in a tree
-//    if (map[row][col] == TREE)
-//    {
-//        framesInTree += moveFrequency;
-//    }
-//    else
-//    {
-//        // Not in tree, reset counter
-//        framesInTree = 0;
-//    }
-//
-//    if (framesInTree >= MAX_TREE_FRAMES)
-//    {
-//        // We've been in a tree too long!
-//        // Reset the counter to avoid spamming the log
-//        framesInTree = 0;
-//        std::cout << "Team " << team << " " << symbol << " hiding in tree too long!" << std::endl;
-//        return true; // Signal that we are stuck
-//    }
-//
-//    return false; // Not stuck
-//}
-
-bool Unit::checkTreeHidingLimit(int map[][MAP_SIZE], std::vector<Unit*>& allUnits)
+bool Unit::checkTreeHidingLimit(const Grid<int>& map)
 {
     const int MAX_TREE_FRAMES = 600;
 
@@ -751,7 +978,7 @@ bool Unit::checkTreeHidingLimit(int map[][MAP_SIZE], std::vector<Unit*>& allUnit
 
         if (framesInTree >= MAX_TREE_FRAMES)
         {
-            std::cout << "Team " << team << " " << symbol << " hiding in tree too long!" << std::endl;
+            LOG_DEBUG(LOG_MOVEMENT, "Team " << team << " " << symbol << " hiding in tree too long!");
             return true;
         }
     }
@@ -763,19 +990,24 @@ bool Unit::checkTreeHidingLimit(int map[][MAP_SIZE], std::vector<Unit*>& allUnit
     return false;
 }
 
-bool Unit::findNearestOpenSpace(int map[][MAP_SIZE], int& openRow, int& openCol)
+bool Unit::findNearestOpenSpace(const Grid<int>& map, int& openRow, int& openCol)
 {
-    std::queue<Node*> bfsQueue;
-    std::vector<std::vector<bool>> visited(MAP_SIZE, std::vector<bool>(MAP_SIZE, false));
-
-    Node* startNode = new Node(row, col);
-    bfsQueue.push(startNode);
-    visited[row][col] = true;
-
-    while (!bfsQueue.empty())
+    NodePool& nodePool = scratch.nodePool;
+    std::vector<Node*>& bfsQueue = scratch.bfsQueue;
+    CellMarks& visited = scratch.visited;
+    const int cols = map.getCols();
+    nodePool.reset(map.getCellCount());
+    bfsQueue.clear();
+    visited.reset(map.getCellCount());
+
+    Node* startNode = nodePool.create(row, col);
+    bfsQueue.push_back(startNode);
+    visited.mark(row * cols + col);
+    size_t queueHead = 0;
+
+    while (queueHead < bfsQueue.size())
     {
-        Node* current = bfsQueue.front();
-        bfsQueue.pop();
+        Node* current = bfsQueue[queueHead++];
 
         int r = current->getRow();
         int c = current->getCol();
@@ -785,17 +1017,13 @@ bool Unit::findNearestOpenSpace(int map[][MAP_SIZE], int& openRow, int& openCol)
         {
             openRow = r;
             openCol = c;
-            delete current;
-            while (!bfsQueue.empty()) { delete bfsQueue.front(); bfsQueue.pop(); }
+            nodePool.reset(0);
             return true;
         }
 
         // Limit search depth
         if (current->getDepth() >= MAX_BFS_DEPTH)
-        {
-            delete current;
             continue;
-        }
 
         int deltaRow[] = { 0, -1, 1, 0 };
         int deltaCol[] = { 1, 0, 0, -1 };
@@ -806,66 +1034,14 @@ bool Unit::findNearestOpenSpace(int map[][MAP_SIZE], int& openRow, int& openCol)
             int newCol = c + deltaCol[dir];
 
             // Must be a valid move to be part of the path
-            if (isValidMove(map, newRow, newCol) && !visited[newRow][newCol])
+            if (isValidMove(map, newRow, newCol) && !visited.contains(newRow * cols + newCol))
             {
-                visited[newRow][newCol] = true;
-                Node* neighbor = new Node(current, newRow, newCol);
-                bfsQueue.push(neighbor);
+                visited.mark(newRow * cols + newCol);
+                Node* neighbor = nodePool.create(current, newRow, newCol);
+                bfsQueue.push_back(neighbor);
             }
         }
-        delete current;
     }
+    nodePool.reset(0);
     return false; // No open space found
 }
-
-void Unit::show() const
-{
-    if (!alive)
-        return;
-
-    glColor3d(colorR, colorG, colorB);
-    glBegin(GL_POLYGON);
-    glVertex2d(col + 0.1, row + 0.1);
-    glVertex2d(col + 0.9, row + 0.1);
-    glVertex2d(col + 0.9, row + 0.9);
-    glVertex2d(col + 0.1, row + 0.9);
-    glEnd();
-
-    if (team == TEAM_BLUE)
-        glColor3d(Colors::BLUE_DARK_R, Colors::BLUE_DARK_G, Colors::BLUE_DARK_B);
-    else
-        glColor3d(Colors::ORANGE_DARK_R, Colors::ORANGE_DARK_G, Colors::ORANGE_DARK_B);
-
-    glLineWidth(2.0f);
-    glBegin(GL_LINE_LOOP);
-    glVertex2d(col + 0.1, row + 0.1);
-    glVertex2d(col + 0.9, row + 0.1);
-    glVertex2d(col + 0.9, row + 0.9);
-    glVertex2d(col + 0.1, row + 0.9);
-    glEnd();
-
-    glColor3d(Colors::TEXT_R, Colors::TEXT_G, Colors::TEXT_B);
-    glRasterPos2d(col + 0.265, row + 0.7);
-    glutBitmapCharacter(GLUT_BITMAP_HELVETICA_18, symbol);
-
-    if (health < MAX_HEALTH)
-    {
-        double healthPercent = (double)health / MAX_HEALTH;
-
-        glColor3d(1.0, 0.0, 0.0);
-        glBegin(GL_POLYGON);
-        glVertex2d(col + 0.1, row + 0.0);
-        glVertex2d(col + 0.9, row + 0.0);
-        glVertex2d(col + 0.9, row + 0.1);
-        glVertex2d(col + 0.1, row + 0.1);
-        glEnd();
-
-        glColor3d(0.0, 1.0, 0.0);
-        glBegin(GL_POLYGON);
-        glVertex2d(col + 0.1, row + 0.0);
-        glVertex2d(col + 0.1 + 0.8 * healthPercent, row + 0.0);
-        glVertex2d(col + 0.1 + 0.8 * healthPercent, row + 0.1);
-        glVertex2d(col + 0.1, row + 0.1);
-        glEnd();
-    }
-}
\ No newline at end of file
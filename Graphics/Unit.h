@@ -1,8 +1,15 @@
 #pragma once
 #include "Definitions.h"
 #include "Node.h"
+#include "MatchContext.h"
+#include "BitGrid.h"
+#include "Grid.h"
 #include <vector>
 
+class TeamRoster;
+class PathCache;
+class DepotField;
+
 /**
  * Unit class - Base class for all combat units
  * Handles position, health, visibility, and basic movement
@@ -10,16 +17,20 @@
 class Unit
 {
 protected:
-    int row, col;           // Current position
+    int id;                 // Index of the unit in its match (NO_UNIT until spawned)
+    int row, col;           // Current position (change through setPosition)
+    int shownRow, shownCol; // Position other units see - where the unit stood when a parallel frame began
     int team;               // TEAM_BLUE or TEAM_ORANGE
     int unitType;           // COMMANDER, WARRIOR, MEDIC, SUPPLY
     int health;             // Current health (0-100)
     bool alive;             // Is unit alive
     char symbol;            // Display symbol (C, W, M, P)
-    double colorR, colorG, colorB; // Team color
     int moveFrequency;      // Frames between moves (different per unit type)
     int movementCounter;    // Counter for movement timing
-    bool visibilityMap[MAP_SIZE][MAP_SIZE];    // Visibility map for this unit
+    BitGrid visibilityMap;  // Visibility map for this unit (one bit per cell, sized to the map)
+    int visibleTop;         // First row the last visibility update may have set
+    int visibleRowCount;    // Rows the last visibility update may have set (0 if none)
+    MatchContext* context;  // Services of the match this unit plays in (may be null)
 
     // Pattern detection for infinite loops (tracks last 8 positions)
     int posHistory[8][2]; // Stores last 8 (row, col) positions
@@ -31,6 +42,20 @@ protected:
     bool escapingTree;
     int stuckInTreeCounter;  // Counter for how many times we tried to escape tree
 
+    struct PathSearch; // Runs findPathAStarIn with the dimensions picked by DispatchGridDims
+
+    /**
+     * A* body, specialized on the map dimensions (see GridDims.h)
+     */
+    template <typename Dims>
+    std::vector<std::pair<int, int>> findPathAStarIn(
+        const Dims& dims,
+        const Grid<int>& map,
+        const Grid<int>& safetyMap,
+        int targetRow,
+        int targetCol,
+        std::vector<Unit*>& allUnits
+    );
 
 public:
     /**
@@ -44,15 +69,51 @@ public:
     virtual ~Unit();
 
     // Getters
-    int getRow() const { return row; }
-    int getCol() const { return col; }
+    int getId() const { return id; }
+    int getRow() const { return shownRow; }
+    int getCol() const { return shownCol; }
     int getTeam() const { return team; }
+    int getEnemyTeam() const { return (team == TEAM_BLUE) ? TEAM_ORANGE : TEAM_BLUE; }
     int getUnitType() const { return unitType; }
     int getHealth() const { return health; }
     bool isAlive() const { return alive; }
     char getSymbol() const { return symbol; }
     int getMoveFrequency() const { return moveFrequency; }
 
+    /**
+     * Attach the unit to the services of the match it plays in
+     */
+    void setContext(MatchContext* ctx) { context = ctx; }
+
+    void setId(int unitId) { id = unitId; }
+
+    /**
+     * Move the unit to (r, c), keeping the match occupancy grid in sync
+     * During a parallel frame only the unit itself moves on (so a multi-cell escape still ends where
+     * it should); everyone else sees it where the frame began until the frame commits the move
+     */
+    void setPosition(int r, int c);
+
+    /**
+     * Back to where the parallel frame began - the simulation then commits or drops the recorded move
+     */
+    void rollbackMove() { row = shownRow; col = shownCol; }
+
+    /**
+     * Hit target for damage (during a parallel frame the hit lands when the frame commits)
+     */
+    void damageUnit(Unit* target, int damage);
+
+    /**
+     * Random integer in [0, bound) from the match generator (rand() when the unit has no match)
+     */
+    int randomInt(int bound) const;
+
+    /**
+     * Record a telemetry event for this unit (no-op when the match is not recording)
+     */
+    void recordEvent(int kind, int a = 0, int b = 0, int c = 0, int d = 0) const;
+
     /**
      * Check if unit should move this frame
      */
@@ -71,49 +132,97 @@ public:
     /**
      * Check if position is valid for movement (includes depot check)
      */
-    bool isValidMove(int map[][MAP_SIZE], int r, int c) const;
+    bool isValidMove(const Grid<int>& map, int r, int c) const;
 
     /**
      * Check if position is occupied by another unit
      */
     bool isPositionOccupied(int r, int c, std::vector<Unit*>& allUnits) const;
 
+    /**
+     * Alive units of ofTeam within Manhattan distance range of this unit, in id order
+     */
+    void findUnitsInRange(int range, int ofTeam, std::vector<Unit*>& allUnits, std::vector<Unit*>& result) const;
+
+    /**
+     * Nearest alive unit of ofTeam and type (ANY_UNIT_TYPE for all) that accept returns true for
+     * (null accepts all) - the lowest id on ties, null if there is none
+     */
+    Unit* findNearestUnit(int ofTeam, int type, std::vector<Unit*>& allUnits, bool (*accept)(const Unit*) = nullptr) const;
+
+    /**
+     * Alive units of this unit's team by role - the match roster, or one built from allUnits
+     * when the unit plays without a match (valid until the next call on this thread)
+     */
+    const TeamRoster& getTeamRoster(std::vector<Unit*>& allUnits) const;
+
+    /**
+     * Alive units of rosterTeam by role - getTeamRoster for either team (the standalone roster of
+     * each team stays valid until the next call for that team on this thread)
+     */
+    const TeamRoster& getRoster(int rosterTeam, std::vector<Unit*>& allUnits) const;
+
     /**
      * Check if position is valid AND not occupied
      */
-    bool isPositionAvailable(int map[][MAP_SIZE], int r, int c, std::vector<Unit*>& allUnits) const;
+    bool isPositionAvailable(const Grid<int>& map, int r, int c, std::vector<Unit*>& allUnits) const;
 
     /**
      * Check if can see position (line of sight)
      */
-    bool canSeePosition(int map[][MAP_SIZE], int targetRow, int targetCol) const;
+    bool canSeePosition(const Grid<int>& map, int targetRow, int targetCol) const;
 
     /**
      * Update visibility map for this unit
      */
-    void updateVisibilityMap(int map[][MAP_SIZE]);
+    void updateVisibilityMap(const Grid<int>& map);
 
     /**
      * Get visibility map
      */
     bool getVisibility(int r, int c) const;
 
+    /**
+     * Whole visibility map, for word-wide merges
+     */
+    const BitGrid& getVisibilityMap() const { return visibilityMap; }
+
+    /**
+     * OR this unit's visibility into target (a grid the size of the map) - only touches the rows it can see
+     */
+    void orVisibilityInto(BitGrid& target) const;
+
+    /**
+     * Path to a cell next to (targetRow, targetCol) from the team's path cache: a cached path that
+     * passes through this unit's cell, trimmed or extended by one cell when the target has moved
+     * one cell since. False if the cache cannot answer
+     */
+    bool findCachedPath(const Grid<int>& map, PathCache& cache, int targetRow, int targetCol,
+        std::vector<std::pair<int, int>>& path) const;
+
     /**
      * Find path using A* algorithm with safety consideration and unit collision
      */
     std::vector<std::pair<int, int>> findPathAStar(
-        int map[][MAP_SIZE],
-        int safetyMap[][MAP_SIZE],
+        const Grid<int>& map,
+        const Grid<int>& safetyMap,
         int targetRow,
         int targetCol,
         std::vector<Unit*>& allUnits
     );
 
+    /**
+     * Step one cell down a depot field - to the free neighbour one step closer to the depot with
+     * the least danger (stays put if those are taken). False if the depot cannot be reached from here
+     */
+    bool descendField(const Grid<int>& map, const Grid<int>& safetyMap, const DepotField& field,
+        std::vector<Unit*>& allUnits);
+
     /**
      * Find nearest cover using BFS
      */
     bool findNearestCover(
-        int map[][MAP_SIZE],
+        const Grid<int>& map,
         int& coverRow,
         int& coverCol
     );
@@ -122,7 +231,7 @@ public:
      * Find nearest open space (non-tree) using BFS
      */
     bool findNearestOpenSpace(
-        int map[][MAP_SIZE],
+        const Grid<int>& map,
         int& openRow,
         int& openCol
     );
@@ -130,36 +239,31 @@ public:
     /**
      * Move one step towards target with collision avoidance
      */
-    void moveTowards(int targetRow, int targetCol, int map[][MAP_SIZE], std::vector<Unit*>& allUnits);
+    void moveTowards(int targetRow, int targetCol, const Grid<int>& map, std::vector<Unit*>& allUnits);
 
     /**
      * Try to unstuck if unit is stuck in same position
      */
-    void tryUnstuck(int map[][MAP_SIZE], std::vector<Unit*>& allUnits);
+    void tryUnstuck(const Grid<int>& map, std::vector<Unit*>& allUnits);
 
     /**
      * Detect repeating patterns: A->B, A->B->C, A->B->C->D cycles
      * Returns true if pattern detected and unit forced to break free
      */
-    bool detectRepeatingPattern(int map[][MAP_SIZE], std::vector<Unit*>& allUnits);
+    bool detectRepeatingPattern(const Grid<int>& map, std::vector<Unit*>& allUnits);
 
     /**
      * Check if hiding in tree for too long (>10 seconds) and force exit
      * Returns true if forced to leave tree
      */
-    bool checkTreeHidingLimit(int map[][MAP_SIZE], std::vector<Unit*>& allUnits);
-
-    /**
-     * Display unit on screen
-     */
-    virtual void show() const;
+    bool checkTreeHidingLimit(const Grid<int>& map);
 
     /**
      * Update unit behavior (to be overridden by derived classes)
      */
     virtual void update(
-        int map[][MAP_SIZE],
-        int safetyMap[][MAP_SIZE],
+        const Grid<int>& map,
+        const Grid<int>& safetyMap,
         std::vector<Unit*>& allUnits
     ) = 0;
 };
@@ -0,0 +1,115 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+
+/**
+ * UnitScheduler class - Timing wheel of the frames at which units act next
+ * Every unit sits in the slot of its next action frame (frame modulo WHEEL_SIZE), so a frame
+ * only touches the units due in it instead of testing every unit against its move frequency.
+ * Frames must be taken in increasing order; frames without entries may be skipped
+ */
+class UnitScheduler
+{
+private:
+    static const int WHEEL_SIZE = 512; // Slots - a power of two above every move frequency
+
+    struct Entry
+    {
+        int id;
+        int frame; // Entries more than a lap ahead share the slot and wait for their frame
+    };
+
+    std::vector<std::vector<Entry>> slots;
+    int count; // Entries in the wheel
+
+public:
+    UnitScheduler() : slots(WHEEL_SIZE), count(0) {}
+
+    /**
+     * Remove all entries
+     */
+    void clear();
+
+    /**
+     * Unit id acts at frame
+     */
+    void schedule(int id, int frame);
+
+    /**
+     * Take the units due at frame out of the wheel, in id order
+     */
+    void popDue(int frame, std::vector<int>& due);
+
+    /**
+     * First frame after the given one with a scheduled unit, -1 if the wheel is empty
+     */
+    int nextFrame(int after) const;
+
+    bool empty() const { return count == 0; }
+};
+
+// Implementation:
+inline void UnitScheduler::clear()
+{
+    for (auto& slot : slots)
+        slot.clear();
+    count = 0;
+}
+
+inline void UnitScheduler::schedule(int id, int frame)
+{
+    Entry entry;
+    entry.id = id;
+    entry.frame = frame;
+    slots[frame & (WHEEL_SIZE - 1)].push_back(entry);
+    count++;
+}
+
+inline void UnitScheduler::popDue(int frame, std::vector<int>& due)
+{
+    due.clear();
+    std::vector<Entry>& slot = slots[frame & (WHEEL_SIZE - 1)];
+
+    // Keep the entries of later laps in place
+    size_t kept = 0;
+    for (size_t i = 0; i < slot.size(); i++)
+    {
+        if (slot[i].frame == frame)
+            due.push_back(slot[i].id);
+        else
+            slot[kept++] = slot[i];
+    }
+    slot.resize(kept);
+    count -= (int)due.size();
+
+    // Same order as a scan of all units
+    std::sort(due.begin(), due.end());
+}
+
+inline int UnitScheduler::nextFrame(int after) const
+{
+    if (count == 0)
+        return -1;
+
+    // Walk one lap of slots - the first entry due within the lap wins
+    for (int frame = after + 1; frame <= after + WHEEL_SIZE; frame++)
+    {
+        for (const Entry& entry : slots[frame & (WHEEL_SIZE - 1)])
+        {
+            if (entry.frame == frame)
+                return frame;
+        }
+    }
+
+    // Everything is more than a lap away
+    int best = -1;
+    for (const auto& slot : slots)
+    {
+        for (const Entry& entry : slot)
+        {
+            if (entry.frame > after && (best == -1 || entry.frame < best))
+                best = entry.frame;
+        }
+    }
+    return best;
+}
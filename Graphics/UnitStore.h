@@ -0,0 +1,92 @@
+#pragma once
+#include "Definitions.h"
+#include <vector>
+
+class Unit;
+
+/**
+ * UnitStore class - Hot per-unit state of a match as parallel arrays, indexed by unit id
+ * Position, team, type, alive flag and movement timer sit in contiguous arrays, so the
+ * per-frame scans of the simulation (who moves, who is a danger source, who is still alive) stream
+ * through memory instead of chasing Unit pointers. The Unit objects keep the cold data (behaviour
+ * state, visibility, paths) and write every hot change through to the store
+ */
+class UnitStore
+{
+private:
+    std::vector<int> rows, cols;
+    std::vector<unsigned char> teams, types;
+    std::vector<unsigned char> alive;
+    std::vector<int> moveFrequency; // Frames between updates
+    std::vector<Unit*> units;       // Cold data of each id
+    int aliveCount[2];              // Alive units per team
+
+public:
+    UnitStore() { clear(); }
+
+    /**
+     * Remove all units
+     */
+    void clear();
+
+    /**
+     * Add a unit with its current state - returns its id
+     */
+    int add(Unit* unit, int r, int c, int team, int type, int frequency);
+
+    /**
+     * Unit id moved to (r, c)
+     */
+    void setPosition(int id, int r, int c) { rows[id] = r; cols[id] = c; }
+
+    /**
+     * Unit id died
+     */
+    void markDead(int id);
+
+    int size() const { return (int)units.size(); }
+    int getRow(int id) const { return rows[id]; }
+    int getCol(int id) const { return cols[id]; }
+    int getTeam(int id) const { return teams[id]; }
+    int getType(int id) const { return types[id]; }
+    bool isAlive(int id) const { return alive[id] != 0; }
+    int getMoveFrequency(int id) const { return moveFrequency[id]; }
+    int getAliveCount(int team) const { return aliveCount[team]; }
+    Unit* getUnit(int id) const { return units[id]; }
+};
+
+// Implementation:
+inline void UnitStore::clear()
+{
+    rows.clear();
+    cols.clear();
+    teams.clear();
+    types.clear();
+    alive.clear();
+    moveFrequency.clear();
+    units.clear();
+    aliveCount[TEAM_BLUE] = 0;
+    aliveCount[TEAM_ORANGE] = 0;
+}
+
+inline int UnitStore::add(Unit* unit, int r, int c, int team, int type, int frequency)
+{
+    rows.push_back(r);
+    cols.push_back(c);
+    teams.push_back((unsigned char)team);
+    types.push_back((unsigned char)type);
+    alive.push_back(1);
+    moveFrequency.push_back(frequency);
+    units.push_back(unit);
+    aliveCount[team]++;
+    return (int)units.size() - 1;
+}
+
+inline void UnitStore::markDead(int id)
+{
+    if (!alive[id])
+        return;
+
+    alive[id] = 0;
+    aliveCount[teams[id]]--;
+}
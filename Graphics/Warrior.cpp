@@ -2,9 +2,18 @@
 #include "Projectiles.h"
 #include "Medic.h"
 #include "Supply.h"
-#include <iostream>
+#include "Log.h"
+#include "Telemetry.h"
 #include <cmath>
 
+namespace
+{
+    thread_local std::vector<Unit*> targets; // Range query results, reused by every warrior on the thread
+
+    bool MedicHasCharges(const Unit* unit) { return static_cast<const Medic*>(unit)->hasCharges(); }
+    bool SupplyHasCharges(const Unit* unit) { return static_cast<const Supply*>(unit)->hasCharges(); }
+}
+
 Warrior::Warrior(int startRow, int startCol, int teamId)
     : Unit(startRow, startCol, teamId, WARRIOR, 'W')
 {
@@ -19,8 +28,8 @@ Warrior::Warrior(int startRow, int startCol, int teamId)
 
 }
 void Warrior::update(
-    int map[][MAP_SIZE],
-    int safetyMap[][MAP_SIZE],
+    const Grid<int>& map,
+    const Grid<int>& safetyMap,
     std::vector<Unit*>& allUnits)
 {
     if (!alive)
@@ -34,7 +43,7 @@ void Warrior::update(
         framesInTree = 0;
         currentPath.clear();
         pathIndex = 0;
-        std::cout << "Team " << team << " Warrior successfully escaped tree!" << std::endl;
+        LOG_DEBUG(LOG_MOVEMENT, "Team " << team << " Warrior successfully escaped tree!");
     }
 
     if (detectRepeatingPattern(map, allUnits))
@@ -43,7 +52,7 @@ void Warrior::update(
         pathIndex = 0;
     }
 
-    if (checkTreeHidingLimit(map, allUnits))
+    if (checkTreeHidingLimit(map))
     {
         escapingTree = true;
         currentPath.clear();
@@ -54,7 +63,7 @@ void Warrior::update(
         // If stuck in tree for more than 5 seconds - force direct escape!
         if (framesInTree >= 300)  // 5 seconds at 60 FPS
         {
-            std::cout << "Team " << team << " Warrior FORCING escape after 5 seconds!" << std::endl;
+            LOG_DEBUG(LOG_MOVEMENT, "Team " << team << " Warrior FORCING escape after 5 seconds!");
 
             int deltaRow[] = { 0, -1, 1, 0, -1, 1, -1, 1 };
             int deltaCol[] = { 1, 0, 0, -1, 1, -1, -1, 1 };
@@ -66,8 +75,7 @@ void Warrior::update(
 
                 if (isPositionAvailable(map, newRow, newCol, allUnits))
                 {
-                    row = newRow;
-                    col = newCol;
+                    setPosition(newRow, newCol);
 
                     // Check if we left the tree
                     if (map[row][col] != TREE)
@@ -76,33 +84,33 @@ void Warrior::update(
                         framesInTree = 0;
                         currentPath.clear();
                         pathIndex = 0;
-                        std::cout << "Team " << team << " Warrior FORCED escape successful!" << std::endl;
+                        LOG_DEBUG(LOG_MOVEMENT, "Team " << team << " Warrior FORCED escape successful!");
                     }
                     return;
                 }
             }
 
-            std::cout << "Team " << team << " Warrior can't escape - completely surrounded!" << std::endl;
+            LOG_WARN(LOG_MOVEMENT, "Team " << team << " Warrior can't escape - completely surrounded!");
         }
 
-        std::cout << "Team " << team << " Warrior at (" << row << "," << col
-            << ") in escapingTree mode, map[row][col]=" << map[row][col] << std::endl;
+        LOG_DEBUG(LOG_MOVEMENT, "Team " << team << " Warrior at (" << row << "," << col
+            << ") in escapingTree mode, map[row][col]=" << map[row][col]);
 
         if (currentPath.empty() || pathIndex >= currentPath.size())
         {
-            std::cout << "Team " << team << " Warrior building new escape path..." << std::endl;
+            LOG_DEBUG(LOG_MOVEMENT, "Team " << team << " Warrior building new escape path...");
             int openRow, openCol;
             if (findNearestOpenSpace(map, openRow, openCol))
             {
-                std::cout << "Team " << team << " Warrior at (" << row << "," << col
-                    << ") found path to open space at (" << openRow << "," << openCol << ")" << std::endl;
+                LOG_DEBUG(LOG_MOVEMENT, "Team " << team << " Warrior at (" << row << "," << col
+                    << ") found path to open space at (" << openRow << "," << openCol << ")");
                 currentPath = findPathAStar(map, safetyMap, openRow, openCol, allUnits);
                 pathIndex = 0;
-                std::cout << "Path has " << currentPath.size() << " steps" << std::endl;
+                LOG_DEBUG(LOG_MOVEMENT, "Path has " << currentPath.size() << " steps");
             }
             else
             {
-                std::cout << "Team " << team << " Warrior can't find open space, trying direct escape" << std::endl;
+                LOG_DEBUG(LOG_MOVEMENT, "Team " << team << " Warrior can't find open space, trying direct escape");
 
                 int deltaRow[] = { 0, -1, 1, 0, -1, 1, -1, 1 };
                 int deltaCol[] = { 1, 0, 0, -1, 1, -1, -1, 1 };
@@ -112,36 +120,35 @@ void Warrior::update(
                     int newRow = row + deltaRow[dir];
                     int newCol = col + deltaCol[dir];
 
-                    std::cout << "  Trying direction " << dir << ": (" << newRow << "," << newCol
+                    LOG_DEBUG(LOG_MOVEMENT, "  Trying direction " << dir << ": (" << newRow << "," << newCol
                         << ") available=" << isPositionAvailable(map, newRow, newCol, allUnits)
-                        << " isTree=" << (map[newRow][newCol] == TREE) << std::endl;
+                        << " isTree=" << (map[newRow][newCol] == TREE));
 
                     if (isPositionAvailable(map, newRow, newCol, allUnits) && map[newRow][newCol] != TREE)
                     {
-                        row = newRow;
-                        col = newCol;
+                        setPosition(newRow, newCol);
                         stuckInTreeCounter = 0;
-                        std::cout << "Team " << team << " Warrior escaped tree directly to ("
-                            << row << "," << col << ")" << std::endl;
+                        LOG_DEBUG(LOG_MOVEMENT, "Team " << team << " Warrior escaped tree directly to ("
+                            << row << "," << col << ")");
                         return;
                     }
                 }
 
-                std::cout << "Team " << team << " Warrior STUCK - no escape found!" << std::endl;
+                LOG_WARN(LOG_MOVEMENT, "Team " << team << " Warrior STUCK - no escape found!");
                 return;
             }
         }
 
         if (!currentPath.empty() && pathIndex < currentPath.size())
         {
-            std::cout << "Team " << team << " Warrior following path, index=" << pathIndex
-                << "/" << currentPath.size() << std::endl;
+            LOG_DEBUG(LOG_MOVEMENT, "Team " << team << " Warrior following path, index=" << pathIndex
+                << "/" << currentPath.size());
 
             auto nextPos = currentPath[pathIndex];
             if (nextPos.first == row && nextPos.second == col)
             {
                 pathIndex++;
-                std::cout << "  Already at path position, advancing to " << pathIndex << std::endl;
+                LOG_DEBUG(LOG_MOVEMENT, "  Already at path position, advancing to " << pathIndex);
                 if (pathIndex < currentPath.size())
                     nextPos = currentPath[pathIndex];
             }
@@ -155,12 +162,12 @@ void Warrior::update(
                     currentPath.clear();
                     pathIndex = 0;
                     stuckInTreeCounter = 0;
-                    std::cout << "Team " << team << " Warrior completed escape path and left tree!" << std::endl;
+                    LOG_DEBUG(LOG_MOVEMENT, "Team " << team << " Warrior completed escape path and left tree!");
                     return;
                 }
                 else
                 {
-                    std::cout << "Team " << team << " Warrior reached end of path but still in tree. Recalculating..." << std::endl;
+                    LOG_DEBUG(LOG_MOVEMENT, "Team " << team << " Warrior reached end of path but still in tree. Recalculating...");
                     currentPath.clear();
                     pathIndex = 0;
                     return;
@@ -170,21 +177,20 @@ void Warrior::update(
             if (pathIndex < currentPath.size())
             {
                 nextPos = currentPath[pathIndex];
-                std::cout << "  Next position: (" << nextPos.first << "," << nextPos.second
-                    << ") available=" << isPositionAvailable(map, nextPos.first, nextPos.second, allUnits) << std::endl;
+                LOG_DEBUG(LOG_MOVEMENT, "  Next position: (" << nextPos.first << "," << nextPos.second
+                    << ") available=" << isPositionAvailable(map, nextPos.first, nextPos.second, allUnits));
 
                 if (isPositionAvailable(map, nextPos.first, nextPos.second, allUnits))
                 {
-                    row = nextPos.first;
-                    col = nextPos.second;
+                    setPosition(nextPos.first, nextPos.second);
                     pathIndex++;
                     stuckInTreeCounter = 0;  // Reset counter because we moved!
-                    std::cout << "Team " << team << " Warrior moved along path to ("
-                        << row << "," << col << ")" << std::endl;
+                    LOG_DEBUG(LOG_MOVEMENT, "Team " << team << " Warrior moved along path to ("
+                        << row << "," << col << ")");
                 }
                 else
                 {
-                    std::cout << "  Path blocked! Trying alternative..." << std::endl;
+                    LOG_DEBUG(LOG_MOVEMENT, "  Path blocked! Trying alternative...");
 
                     int deltaRow[] = { 0, -1, 1, 0, -1, 1, -1, 1 };
                     int deltaCol[] = { 1, 0, 0, -1, 1, -1, -1, 1 };
@@ -197,21 +203,20 @@ void Warrior::update(
 
                         if (isPositionAvailable(map, newRow, newCol, allUnits) && map[newRow][newCol] != TREE)
                         {
-                            row = newRow;
-                            col = newCol;
+                            setPosition(newRow, newCol);
                             moved = true;
                             currentPath.clear();
                             pathIndex = 0;
                             stuckInTreeCounter = 0;
-                            std::cout << "Team " << team << " Warrior found alternative escape to ("
-                                << row << "," << col << ")" << std::endl;
+                            LOG_DEBUG(LOG_MOVEMENT, "Team " << team << " Warrior found alternative escape to ("
+                                << row << "," << col << ")");
                             break;
                         }
                     }
 
                     if (!moved)
                     {
-                        std::cout << "Team " << team << " Warrior COMPLETELY STUCK!" << std::endl;
+                        LOG_WARN(LOG_MOVEMENT, "Team " << team << " Warrior COMPLETELY STUCK!");
                         currentPath.clear();
                         pathIndex = 0;
                     }
@@ -229,7 +234,7 @@ void Warrior::update(
         needsMedic = false;
         currentPath.clear();
         pathIndex = 0;
-        std::cout << "Team " << team << " Warrior healed - resuming attack mode!" << std::endl;
+        LOG_INFO(LOG_SUPPORT, "Team " << team << " Warrior healed - resuming attack mode!");
     }
 
     if (health < CRITICAL_HEALTH)
@@ -267,91 +272,82 @@ bool Warrior::checkHealthStatus()
     bool needsHelp = (health < CRITICAL_HEALTH);
     if (needsHelp && !needsMedic) // Just started needing help
     {
-        std::cout << "!!! Team " << team << " Warrior at (" << row << "," << col
-            << ") needs medic! Health: " << health << " !!!" << std::endl;
+        LOG_INFO(LOG_SUPPORT, "!!! Team " << team << " Warrior at (" << row << "," << col
+            << ") needs medic! Health: " << health << " !!!");
     }
     else if (needsHelp && needsMedic) // Still needs help
     {
-        std::cout << "Team " << team << " Warrior at (" << row << "," << col
-            << ") STILL needs medic! Health: " << health << std::endl;
+        LOG_INFO(LOG_SUPPORT, "Team " << team << " Warrior at (" << row << "," << col
+            << ") STILL needs medic! Health: " << health);
     }
     return needsHelp;
 }
 
-bool Warrior::shootAtEnemy(std::vector<Unit*>& allUnits, int map[][MAP_SIZE])
+bool Warrior::shootAtEnemy(std::vector<Unit*>& allUnits, const Grid<int>& map)
 {
     if (ammo <= 0)
         return false;
 
-    for (auto enemy : allUnits)
+    findUnitsInRange(SHOOTING_RANGE, getEnemyTeam(), allUnits, targets);
+    for (auto enemy : targets)
     {
-        if (enemy->getTeam() != team && enemy->isAlive())
-        {
-            int enemyRow = enemy->getRow();
-            int enemyCol = enemy->getCol();
+        int enemyRow = enemy->getRow();
+        int enemyCol = enemy->getCol();
 
-            int distance = abs(row - enemyRow) + abs(col - enemyCol);
-            if (distance <= SHOOTING_RANGE)
-            {
-                if (canSeePosition(map, enemyRow, enemyCol))
-                {
-                    ammo--;
-                    int baseDamage = 5 + (rand() % 6); // Base Damage range is: 5 - 10
-                    int damage = (int)(baseDamage * 0.85); // Damage range is: 4.25 - 8.5
-                    if (damage < 1) damage = 1; // Minimum 1 damage
+        if (canSeePosition(map, enemyRow, enemyCol))
+        {
+            ammo--;
+            int baseDamage = 5 + randomInt(6); // Base Damage range is: 5 - 10
+            int damage = (int)(baseDamage * 0.85); // Damage range is: 4.25 - 8.5
+            if (damage < 1) damage = 1; // Minimum 1 damage
 
-                    // Create visual bullet
-                    AddProjectile(row, col, enemyRow, enemyCol, team, false);
+            // Create visual bullet
+            AddProjectile(row, col, enemyRow, enemyCol, team, false);
 
-                    enemy->takeDamage(damage);
+            recordEvent(EVENT_SHOT, enemy->getId(), damage, enemyRow, enemyCol);
+            damageUnit(enemy, damage);
 
-                    std::cout << "Team " << team << " Warrior at (" << row << "," << col
-                        << ") shoots enemy at (" << enemyRow << "," << enemyCol
-                        << ") for " << damage << " damage!" << std::endl;
+            LOG_INFO(LOG_COMBAT, "Team " << team << " Warrior at (" << row << "," << col
+                << ") shoots enemy at (" << enemyRow << "," << enemyCol
+                << ") for " << damage << " damage!");
 
-                    return true;
-                }
-            }
+            return true;
         }
     }
 
     return false;
 }
 
-bool Warrior::throwGrenade(std::vector<Unit*>& allUnits, int map[][MAP_SIZE])
+bool Warrior::throwGrenade(std::vector<Unit*>& allUnits, const Grid<int>& map)
 {
     if (grenades <= 0)
         return false;
 
-    for (auto enemy : allUnits)
+    findUnitsInRange(GRENADE_RANGE, getEnemyTeam(), allUnits, targets);
+    for (auto enemy : targets)
     {
-        if (enemy->getTeam() != team && enemy->isAlive())
-        {
-            int enemyRow = enemy->getRow();
-            int enemyCol = enemy->getCol();
+        int enemyRow = enemy->getRow();
+        int enemyCol = enemy->getCol();
 
-            int distance = abs(row - enemyRow) + abs(col - enemyCol);
-            if (distance <= GRENADE_RANGE && distance > 2)
-            {
-                if (canSeePosition(map, enemyRow, enemyCol))
-                {
-                    grenades--;
-                    int baseDamage = 10 + (rand() % 11); // Base Damage range is: 10 - 20
-                    int damage = (int)(baseDamage * 0.85); // Damage range is: 8.5 - 17
-                    if (damage < 1) damage = 1; // Minimum 1 damage
+        int distance = abs(row - enemyRow) + abs(col - enemyCol);
+        if (distance > 2 && canSeePosition(map, enemyRow, enemyCol))
+        {
+            grenades--;
+            int baseDamage = 10 + randomInt(11); // Base Damage range is: 10 - 20
+            int damage = (int)(baseDamage * 0.85); // Damage range is: 8.5 - 17
+            if (damage < 1) damage = 1; // Minimum 1 damage
 
-                    // Create visual grenade
-                    AddProjectile(row, col, enemyRow, enemyCol, team, true);
+            // Create visual grenade
+            AddProjectile(row, col, enemyRow, enemyCol, team, true);
 
-                    enemy->takeDamage(damage);
+            recordEvent(EVENT_GRENADE, enemy->getId(), damage, enemyRow, enemyCol);
+            damageUnit(enemy, damage);
 
-                    std::cout << "Team " << team << " Warrior at (" << row << "," << col
-                        << ") throws grenade at (" << enemyRow << "," << enemyCol
-                        << ") for " << damage << " damage!" << std::endl;
+            LOG_INFO(LOG_COMBAT, "Team " << team << " Warrior at (" << row << "," << col
+                << ") throws grenade at (" << enemyRow << "," << enemyCol
+                << ") for " << damage << " damage!");
 
-                    return true;
-                }
-            }
+            return true;
         }
     }
 
@@ -359,25 +355,11 @@ bool Warrior::throwGrenade(std::vector<Unit*>& allUnits, int map[][MAP_SIZE])
 }
 
 void Warrior::attackMode(
-    int map[][MAP_SIZE],
-    int safetyMap[][MAP_SIZE],
+    const Grid<int>& map,
+    const Grid<int>& safetyMap,
     std::vector<Unit*>& allUnits)
 {
-    Unit* nearestEnemy = nullptr;
-    int minDistance = 9999;
-
-    for (auto enemy : allUnits)
-    {
-        if (enemy->getTeam() != team && enemy->isAlive())
-        {
-            int dist = abs(row - enemy->getRow()) + abs(col - enemy->getCol());
-            if (dist < minDistance)
-            {
-                minDistance = dist;
-                nearestEnemy = enemy;
-            }
-        }
-    }
+    Unit* nearestEnemy = findNearestUnit(getEnemyTeam(), ANY_UNIT_TYPE, allUnits);
 
     if (nearestEnemy == nullptr)
     {
@@ -441,35 +423,14 @@ void Warrior::attackMode(
 }
 
 void Warrior::defenseMode(
-    int map[][MAP_SIZE],
-    int safetyMap[][MAP_SIZE],
+    const Grid<int>& map,
+    const Grid<int>& safetyMap,
     std::vector<Unit*>& allUnits)
 {
     if (health < CRITICAL_HEALTH)
     {
-        Medic* nearestMedic = nullptr;
-        int minDist = 9999;
-
-        for (auto unit : allUnits)
-        {
-            if (unit->getTeam() == team && unit->isAlive() && unit->getUnitType() == MEDIC)
-            {
-                // Cast the Unit* to a Medic*
-                Medic* medic = dynamic_cast<Medic*>(unit);
-                if (!medic) continue;
-
-                // Only consider this medic unit if it has charges!
-                if (medic->hasCharges())
-                {
-                    int dist = abs(row - unit->getRow()) + abs(col - unit->getCol());
-                    if (dist < minDist)
-                    {
-                        minDist = dist;
-                        nearestMedic = medic; // Store the Medic*
-                    }
-                }
-            }
-        }
+        // Only consider medics that still have charges
+        Medic* nearestMedic = static_cast<Medic*>(findNearestUnit(team, MEDIC, allUnits, MedicHasCharges));
 
         if (nearestMedic != nullptr)
         {
@@ -532,29 +493,8 @@ void Warrior::defenseMode(
 
     if (needsAmmo && ammo < LOW_AMMO)
     {
-        Supply* nearestSupply = nullptr;
-        int minDist = 9999;
-
-        for (auto unit : allUnits)
-        {
-            if (unit->getTeam() == team && unit->isAlive() && unit->getUnitType() == SUPPLY)
-            {
-                // Cast the Unit* to a Supply*
-                Supply* supply = dynamic_cast<Supply*>(unit);
-                if (!supply) continue;
-
-                // Only consider this supply unit if it has charges!
-                if (supply->hasCharges())
-                {
-                    int dist = abs(row - unit->getRow()) + abs(col - unit->getCol());
-                    if (dist < minDist)
-                    {
-                        minDist = dist;
-                        nearestSupply = supply; // Store the Supply*
-                    }
-                }
-            }
-        }
+        // Only consider supply units that still have charges
+        Supply* nearestSupply = static_cast<Supply*>(findNearestUnit(team, SUPPLY, allUnits, SupplyHasCharges));
 
         if (nearestSupply != nullptr)
         {
@@ -660,7 +600,7 @@ void Warrior::defenseMode(
     else
     {
         int bestRow = row, bestCol = col;
-        int minDanger = (safetyMap != nullptr) ? safetyMap[row][col] : 0;
+        int minDanger = safetyMap[row][col];
 
         int deltaRow[] = { 0, -1, 1, 0 };
         int deltaCol[] = { 1, 0, 0, -1 };
@@ -672,7 +612,7 @@ void Warrior::defenseMode(
 
             if (isPositionAvailable(map, newRow, newCol, allUnits))
             {
-                int danger = (safetyMap != nullptr) ? safetyMap[newRow][newCol] : 0;
+                int danger = safetyMap[newRow][newCol];
                 if (danger < minDanger)
                 {
                     minDanger = danger;
@@ -684,8 +624,7 @@ void Warrior::defenseMode(
 
         if (bestRow != row || bestCol != col)
         {
-            row = bestRow;
-            col = bestCol;
+            setPosition(bestRow, bestCol);
         }
         else
         {
@@ -707,11 +646,11 @@ void Warrior::refillAmmo(int amount, int grenadeAmount)
     if (grenades > MAX_GRENADES)
         grenades = MAX_GRENADES;
 
-    std::cout << "Warrior refillAmmo called: " << oldAmmo << "->" << ammo
-        << " ammo, " << oldGrenades << "->" << grenades << " grenades" << std::endl;
+    LOG_INFO(LOG_SUPPORT, "Warrior refillAmmo called: " << oldAmmo << "->" << ammo
+        << " ammo, " << oldGrenades << "->" << grenades << " grenades");
 
     needsAmmo = false;
 
-    std::cout << "Team " << team << " Warrior refilled! Ammo: " << ammo
-        << ", Grenades: " << grenades << std::endl;
+    LOG_INFO(LOG_SUPPORT, "Team " << team << " Warrior refilled! Ammo: " << ammo
+        << ", Grenades: " << grenades);
 }
\ No newline at end of file
@@ -28,8 +28,8 @@ public:
      * Update warrior behavior
      */
     void update(
-        int map[][MAP_SIZE],
-        int safetyMap[][MAP_SIZE],
+        const Grid<int>& map,
+        const Grid<int>& safetyMap,
         std::vector<Unit*>& allUnits
     ) override;
 
@@ -46,19 +46,19 @@ public:
     /**
      * Shoot at enemy if in range
      */
-    bool shootAtEnemy(std::vector<Unit*>& allUnits, int map[][MAP_SIZE]);
+    bool shootAtEnemy(std::vector<Unit*>& allUnits, const Grid<int>& map);
 
     /**
      * Throw grenade at enemy
      */
-    bool throwGrenade(std::vector<Unit*>& allUnits, int map[][MAP_SIZE]);
+    bool throwGrenade(std::vector<Unit*>& allUnits, const Grid<int>& map);
 
     /**
      * Find and attack nearest enemy
      */
     void attackMode(
-        int map[][MAP_SIZE],
-        int safetyMap[][MAP_SIZE],
+        const Grid<int>& map,
+        const Grid<int>& safetyMap,
         std::vector<Unit*>& allUnits
     );
 
@@ -66,8 +66,8 @@ public:
      * Find cover and defend
      */
     void defenseMode(
-        int map[][MAP_SIZE],
-        int safetyMap[][MAP_SIZE],
+        const Grid<int>& map,
+        const Grid<int>& safetyMap,
         std::vector<Unit*>& allUnits
     );
 
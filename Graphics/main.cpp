@@ -6,217 +6,29 @@
 #include <vector>
 
 #include "Definitions.h"
-#include "Node.h"
 #include "Unit.h"
-#include "Commander.h"
-#include "Warrior.h"
-#include "Medic.h"
-#include "Supply.h"
+#include "Simulation.h"
+#include "Log.h"
 
 using namespace std;
 
-// Forward declaration for projectile system
-void AddProjectile(double startRow, double startCol, double endRow, double endCol, int team, bool isGrenade);
-
 const int WINDOW_WIDTH = 1000;
 const int WINDOW_HEIGHT = 1000;
 
-// Projectile structure for visual effects
-struct Projectile {
-    double startRow, startCol;  // Starting position
-    double endRow, endCol;      // Target position
-    double currentRow, currentCol; // Current position (animated)
-    int team;                   // Team color
-    bool isGrenade;             // true = grenade, false = bullet
-    int framesAlive;            // How long it's been flying
-    bool active;                // Still animating
-};
-
-// Game state
-int map[MAP_SIZE][MAP_SIZE] = { 0 };
-int safetyMap[MAP_SIZE][MAP_SIZE] = { 0 };
-vector<Unit*> allUnits;
-vector<Projectile> activeProjectiles;
-bool gameRunning = true;
-bool gameOver = false;
-int winningTeam = -1;
-
-// Game timing - GLOBAL frame counter for all units
-int frameCounter = 0;
-
-void InitMap()
-{
-    for (int i = 0; i < MAP_SIZE; i++)
-        for (int j = 0; j < MAP_SIZE; j++)
-            map[i][j] = SPACE;
-
-    for (int cluster = 0; cluster < 8; cluster++)
-    {
-        int centerRow = 5 + rand() % (MAP_SIZE - 10);
-        int centerCol = 5 + rand() % (MAP_SIZE - 10);
-        int clusterSize = 2 + rand() % 4;
-
-        for (int i = 0; i < clusterSize; i++)
-        {
-            int r = centerRow + (rand() % 5) - 2;
-            int c = centerCol + (rand() % 5) - 2;
-            if (r >= 0 && r < MAP_SIZE && c >= 0 && c < MAP_SIZE)
-                map[r][c] = ROCK;
-        }
-    }
-
-    for (int cluster = 0; cluster < 10; cluster++)
-    {
-        int centerRow = 5 + rand() % (MAP_SIZE - 10);
-        int centerCol = 5 + rand() % (MAP_SIZE - 10);
-        int clusterSize = 3 + rand() % 5;
-
-        for (int i = 0; i < clusterSize; i++)
-        {
-            int r = centerRow + (rand() % 6) - 3;
-            int c = centerCol + (rand() % 6) - 3;
-            if (r >= 0 && r < MAP_SIZE && c >= 0 && c < MAP_SIZE && map[r][c] == SPACE)
-                map[r][c] = TREE;
-        }
-    }
-
-    for (int river = 0; river < 3; river++)
-    {
-        int startRow = 10 + rand() % (MAP_SIZE - 20);
-        int startCol = rand() % MAP_SIZE;
-        int direction = rand() % 2;
-
-        for (int i = 0; i < 15 + rand() % 15; i++)
-        {
-            if (direction == 0)
-            {
-                int c = startCol + i;
-                if (c >= 0 && c < MAP_SIZE && map[startRow][c] == SPACE)
-                    map[startRow][c] = WATER;
-            }
-            else
-            {
-                int r = startRow + i;
-                if (r >= 0 && r < MAP_SIZE && map[r][startCol] == SPACE)
-                    map[r][startCol] = WATER;
-            }
-        }
-    }
-
-    for (int i = 0; i < 8; i++)
-        for (int j = 0; j < 8; j++)
-            map[i][j] = SPACE;
-
-    for (int i = MAP_SIZE - 8; i < MAP_SIZE; i++)
-        for (int j = MAP_SIZE - 8; j < MAP_SIZE; j++)
-            map[i][j] = SPACE;
-
-    map[1][6] = AMMO_DEPOT;
-    map[6][1] = MEDICAL_DEPOT;
-
-    map[MAP_SIZE - 2][MAP_SIZE - 7] = AMMO_DEPOT;
-    map[MAP_SIZE - 7][MAP_SIZE - 2] = MEDICAL_DEPOT;
-}
-
-void InitUnits()
-{
-    for (auto unit : allUnits)
-        delete unit;
-    allUnits.clear();
-
-    allUnits.push_back(new Commander(2, 2, TEAM_BLUE));
-    allUnits.push_back(new Warrior(2, 4, TEAM_BLUE));
-    allUnits.push_back(new Warrior(4, 2, TEAM_BLUE));
-    allUnits.push_back(new Medic(6, 2, TEAM_BLUE));      // At medical depot adjacent position
-    allUnits.push_back(new Supply(2, 6, TEAM_BLUE));     // At ammo depot adjacent position
-
-    allUnits.push_back(new Commander(MAP_SIZE - 3, MAP_SIZE - 3, TEAM_ORANGE));
-    allUnits.push_back(new Warrior(MAP_SIZE - 3, MAP_SIZE - 5, TEAM_ORANGE));
-    allUnits.push_back(new Warrior(MAP_SIZE - 5, MAP_SIZE - 3, TEAM_ORANGE));
-    allUnits.push_back(new Medic(23, 27, TEAM_ORANGE));  // At medical depot adjacent position (23,28)
-    allUnits.push_back(new Supply(27, 23, TEAM_ORANGE)); // At ammo depot adjacent position (28,23)
-}
-
-void UpdateSafetyMap()
-{
-    for (int i = 0; i < MAP_SIZE; i++)
-        for (int j = 0; j < MAP_SIZE; j++)
-            safetyMap[i][j] = 0;
-
-    for (auto unit : allUnits)
-    {
-        if (!unit->isAlive())
-            continue;
-
-        int team = unit->getTeam();
-
-        for (auto enemy : allUnits)
-        {
-            if (!enemy->isAlive() || enemy->getTeam() == team)
-                continue;
-
-            int enemyRow = enemy->getRow();
-            int enemyCol = enemy->getCol();
-
-            if (unit->getVisibility(enemyRow, enemyCol))
-            {
-                int dangerRadius = SHOOTING_RANGE + 2;
-                for (int i = enemyRow - dangerRadius; i <= enemyRow + dangerRadius; i++)
-                {
-                    for (int j = enemyCol - dangerRadius; j <= enemyCol + dangerRadius; j++)
-                    {
-                        if (i >= 0 && i < MAP_SIZE && j >= 0 && j < MAP_SIZE)
-                        {
-                            int dist = abs(i - enemyRow) + abs(j - enemyCol);
-                            int danger = max(0, 100 - dist * 10);
-                            safetyMap[i][j] = max(safetyMap[i][j], danger);
-                        }
-                    }
-                }
-            }
-        }
-    }
-}
-
-void CheckGameOver()
-{
-    int blueAlive = 0;
-    int orangeAlive = 0;
-
-    for (auto unit : allUnits)
-    {
-        if (unit->isAlive())
-        {
-            if (unit->getTeam() == TEAM_BLUE)
-                blueAlive++;
-            else
-                orangeAlive++;
-        }
-    }
-
-    if (blueAlive == 0)
-    {
-        gameOver = true;
-        winningTeam = TEAM_ORANGE;
-        gameRunning = false;
-        cout << "=== GAME OVER: TEAM ORANGE WINS! ===" << endl;
-    }
-    else if (orangeAlive == 0)
-    {
-        gameOver = true;
-        winningTeam = TEAM_BLUE;
-        gameRunning = false;
-        cout << "=== GAME OVER: TEAM BLUE WINS! ===" << endl;
-    }
-}
+// Game state - the viewer only renders it and forwards timer ticks
+Simulation game;
+uint64_t nextSeed; // Seed of the next match (logged at match start, replay it with headless_sim seed=...)
 
 void ShowMap()
 {
-    for (int i = 0; i < MAP_SIZE; i++)
+    const int rows = game.getRows();
+    const int cols = game.getCols();
+
+    for (int i = 0; i < rows; i++)
     {
-        for (int j = 0; j < MAP_SIZE; j++)
+        for (int j = 0; j < cols; j++)
         {
-            switch (map[i][j])
+            switch (game.getCell(i, j))
             {
             case SPACE:
                 glColor3d(Colors::BACKGROUND_R, Colors::BACKGROUND_G, Colors::BACKGROUND_B);
@@ -243,7 +55,7 @@ void ShowMap()
             glVertex2d(j, i + 1);
             glEnd();
 
-            if (map[i][j] == ROCK)
+            if (game.getCell(i, j) == ROCK)
             {
                 glColor3d(0.3, 0.3, 0.3);
                 glBegin(GL_TRIANGLES);
@@ -252,7 +64,7 @@ void ShowMap()
                 glVertex2d(j + 0.8, i + 0.8);
                 glEnd();
             }
-            else if (map[i][j] == TREE)
+            else if (game.getCell(i, j) == TREE)
             {
                 glColor3d(0.0, 0.4, 0.1);
                 glBegin(GL_TRIANGLES);
@@ -266,79 +78,86 @@ void ShowMap()
 
     glColor3d(0.4, 0.5, 0.4);
     glLineWidth(0.5f);
-    for (int i = 0; i <= MAP_SIZE; i++)
+    for (int i = 0; i <= rows; i++)
     {
         glBegin(GL_LINES);
         glVertex2d(0, i);
-        glVertex2d(MAP_SIZE, i);
+        glVertex2d(cols, i);
         glEnd();
+    }
 
+    for (int j = 0; j <= cols; j++)
+    {
         glBegin(GL_LINES);
-        glVertex2d(i, 0);
-        glVertex2d(i, MAP_SIZE);
+        glVertex2d(j, 0);
+        glVertex2d(j, rows);
         glEnd();
     }
 }
 
-void AddProjectile(double startRow, double startCol, double endRow, double endCol, int team, bool isGrenade)
-{
-    Projectile proj;
-    proj.startRow = startRow;
-    proj.startCol = startCol;
-    proj.endRow = endRow;
-    proj.endCol = endCol;
-    proj.currentRow = startRow;
-    proj.currentCol = startCol;
-    proj.team = team;
-    proj.isGrenade = isGrenade;
-    proj.framesAlive = 0;
-    proj.active = true;
-    activeProjectiles.push_back(proj);
-
-    std::cout << "Created " << (isGrenade ? "GRENADE" : "BULLET") << " from ("
-        << startRow << "," << startCol << ") to (" << endRow << "," << endCol << ")" << std::endl;
-}
-
-void UpdateProjectiles()
+void ShowUnit(const Unit* unit)
 {
-    const double PROJECTILE_SPEED = 0.5; // Cells per frame
+    if (!unit->isAlive())
+        return;
 
-    for (auto& proj : activeProjectiles)
+    int row = unit->getRow();
+    int col = unit->getCol();
+    int team = unit->getTeam();
+    int health = unit->getHealth();
+
+    if (team == TEAM_BLUE)
+        glColor3d(Colors::BLUE_R, Colors::BLUE_G, Colors::BLUE_B);
+    else
+        glColor3d(Colors::ORANGE_R, Colors::ORANGE_G, Colors::ORANGE_B);
+    glBegin(GL_POLYGON);
+    glVertex2d(col + 0.1, row + 0.1);
+    glVertex2d(col + 0.9, row + 0.1);
+    glVertex2d(col + 0.9, row + 0.9);
+    glVertex2d(col + 0.1, row + 0.9);
+    glEnd();
+
+    if (team == TEAM_BLUE)
+        glColor3d(Colors::BLUE_DARK_R, Colors::BLUE_DARK_G, Colors::BLUE_DARK_B);
+    else
+        glColor3d(Colors::ORANGE_DARK_R, Colors::ORANGE_DARK_G, Colors::ORANGE_DARK_B);
+
+    glLineWidth(2.0f);
+    glBegin(GL_LINE_LOOP);
+    glVertex2d(col + 0.1, row + 0.1);
+    glVertex2d(col + 0.9, row + 0.1);
+    glVertex2d(col + 0.9, row + 0.9);
+    glVertex2d(col + 0.1, row + 0.9);
+    glEnd();
+
+    glColor3d(Colors::TEXT_R, Colors::TEXT_G, Colors::TEXT_B);
+    glRasterPos2d(col + 0.265, row + 0.7);
+    glutBitmapCharacter(GLUT_BITMAP_HELVETICA_18, unit->getSymbol());
+
+    if (health < MAX_HEALTH)
     {
-        if (!proj.active)
-            continue;
-
-        proj.framesAlive++;
-
-        // Move towards target
-        double dx = proj.endCol - proj.currentCol;
-        double dy = proj.endRow - proj.currentRow;
-        double dist = sqrt(dx * dx + dy * dy);
+        double healthPercent = (double)health / MAX_HEALTH;
+
+        glColor3d(1.0, 0.0, 0.0);
+        glBegin(GL_POLYGON);
+        glVertex2d(col + 0.1, row + 0.0);
+        glVertex2d(col + 0.9, row + 0.0);
+        glVertex2d(col + 0.9, row + 0.1);
+        glVertex2d(col + 0.1, row + 0.1);
+        glEnd();
 
-        if (dist < PROJECTILE_SPEED || proj.framesAlive > 60)
-        {
-            // Reached target or timed out
-            proj.active = false;
-        }
-        else
-        {
-            // Move towards target
-            proj.currentCol += (dx / dist) * PROJECTILE_SPEED;
-            proj.currentRow += (dy / dist) * PROJECTILE_SPEED;
-        }
+        glColor3d(0.0, 1.0, 0.0);
+        glBegin(GL_POLYGON);
+        glVertex2d(col + 0.1, row + 0.0);
+        glVertex2d(col + 0.1 + 0.8 * healthPercent, row + 0.0);
+        glVertex2d(col + 0.1 + 0.8 * healthPercent, row + 0.1);
+        glVertex2d(col + 0.1, row + 0.1);
+        glEnd();
     }
-
-    // Remove inactive projectiles
-    activeProjectiles.erase(
-        remove_if(activeProjectiles.begin(), activeProjectiles.end(),
-            [](const Projectile& p) { return !p.active; }),
-        activeProjectiles.end()
-    );
 }
 
 void DrawProjectiles()
 {
-    for (const auto& proj : activeProjectiles)
+    for (const auto& proj : game.getProjectiles())
     {
         if (!proj.active)
             continue;
@@ -384,50 +203,25 @@ void DrawProjectiles()
     }
 }
 
-void UpdateGame()
-{
-    if (!gameRunning)
-        return;
-
-    frameCounter++;
-
-    // Update projectile animations
-    UpdateProjectiles();
-
-    // Update safety map every frame
-    UpdateSafetyMap();
-
-    // Each unit moves at its own frequency
-    for (auto unit : allUnits)
-    {
-        if (unit->isAlive() && unit->shouldMoveThisFrame(frameCounter))
-        {
-            unit->update(map, safetyMap, allUnits);
-        }
-    }
-
-    CheckGameOver();
-}
-
 void display()
 {
     glClear(GL_COLOR_BUFFER_BIT);
 
     ShowMap();
 
-    for (auto unit : allUnits)
+    for (auto unit : game.getUnits())
     {
         if (unit->isAlive())
-            unit->show();
+            ShowUnit(unit);
     }
 
     DrawProjectiles();
 
-    if (gameOver)
+    if (game.isGameOver())
     {
         glColor3d(1.0, 1.0, 1.0);
-        glRasterPos2d(MAP_SIZE / 2 - 2, MAP_SIZE / 2);
-        string msg = (winningTeam == TEAM_BLUE) ? "BLUE TEAM WINS!" : "ORANGE TEAM WINS!";
+        glRasterPos2d(game.getCols() / 2 - 2, game.getRows() / 2);
+        string msg = (game.getWinningTeam() == TEAM_BLUE) ? "BLUE TEAM WINS!" : "ORANGE TEAM WINS!";
         for (char c : msg)
             glutBitmapCharacter(GLUT_BITMAP_TIMES_ROMAN_24, c);
     }
@@ -438,7 +232,7 @@ void display()
 // Timer callback for consistent frame rate (60 FPS)
 void timer(int value)
 {
-    UpdateGame();
+    game.step();
     glutPostRedisplay();
     glutTimerFunc(16, timer, 0); // ~60 FPS (16ms per frame)
 }
@@ -448,19 +242,11 @@ void keyboard(unsigned char key, int x, int y)
     switch (key)
     {
     case ' ':
-        cout << "\n=== NEW GAME STARTED ===" << endl;
-        gameRunning = true;
-        gameOver = false;
-        winningTeam = -1;
-        frameCounter = 0;
-
-        InitMap();
-        InitUnits();
+        LOG_INFO(LOG_MATCH, "=== NEW GAME STARTED ===");
+        game.reset(nextSeed++);
         break;
 
     case 27:
-        for (auto unit : allUnits)
-            delete unit;
         exit(0);
         break;
     }
@@ -468,12 +254,10 @@ void keyboard(unsigned char key, int x, int y)
 
 void init()
 {
-    srand((unsigned int)time(0));
+    nextSeed = (uint64_t)time(0);
     glClearColor(Colors::BACKGROUND_R, Colors::BACKGROUND_G, Colors::BACKGROUND_B, 0);
-    glOrtho(0, MAP_SIZE, MAP_SIZE, 0, -1, 1);
-
-    InitMap();
-    InitUnits();
+    game.reset(nextSeed++);
+    glOrtho(0, game.getCols(), game.getRows(), 0, -1, 1);
 }
 
 int main(int argc, char* argv[])
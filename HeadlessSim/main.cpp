@@ -0,0 +1,144 @@
+#include <stdlib.h>
+#include <time.h>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <sstream>
+
+#include "Definitions.h"
+#include "Simulation.h"
+#include "Log.h"
+#include "Telemetry.h"
+#include "ThreadPool.h"
+
+using namespace std;
+
+/**
+ * Headless runner - plays matches back to back without a window or frame cap
+ * Usage: headless_sim [matches] [maxFrames] [bresenham|shadowcast] [log] [fast] [parallel] [pathcache] [depotfields] [events=<file>] [seed=<n>] [size=<n>] [roster=<w>,<m>,<s>]
+ * Unit logging is off unless "log" is given - batch runs are measured without it.
+ * events=<file> records binary combat telemetry of every match (read it with event_decoder)
+ * Match i is played with seed n + i (n defaults to the current time), so any match can be replayed
+ * size=<n> plays on an n x n battlefield instead of the default MAP_SIZE
+ * roster=<w>,<m>,<s> fields w warriors, m medics and s supply units per team (plus the commander)
+ * fast skips the frames in which no unit acts - same results, no projectile animation
+ * parallel updates the two teams side by side (reproducible, but not the same matches as sequential)
+ * pathcache reuses A* paths while the safety maps are unchanged (also changes the matches)
+ * depotfields walks support units to their depots down precomputed distance fields (changes the matches)
+ */
+int main(int argc, char* argv[])
+{
+    int matches = (argc > 1) ? atoi(argv[1]) : 1;
+    int maxFrames = (argc > 2) ? atoi(argv[2]) : 100000;
+    int fovEngine = (argc > 3 && string(argv[3]) == "shadowcast") ? FOV_SHADOWCAST : FOV_BRESENHAM;
+    bool logging = false;
+    bool fast = false;
+    bool parallel = false;
+    bool pathCache = false;
+    bool depotFields = false;
+    string eventsPath;
+    uint64_t baseSeed = (uint64_t)time(0);
+    int mapSize = MAP_SIZE;
+    Roster roster = { DEFAULT_WARRIORS, DEFAULT_MEDICS, DEFAULT_SUPPLIES };
+
+    for (int i = 4; i < argc; i++)
+    {
+        string option = argv[i];
+        if (option == "log")
+            logging = true;
+        else if (option == "fast")
+            fast = true;
+        else if (option == "parallel")
+            parallel = true;
+        else if (option == "pathcache")
+            pathCache = true;
+        else if (option == "depotfields")
+            depotFields = true;
+        else if (option.compare(0, 7, "events=") == 0)
+            eventsPath = option.substr(7);
+        else if (option.compare(0, 5, "seed=") == 0)
+            baseSeed = strtoull(option.c_str() + 5, nullptr, 10);
+        else if (option.compare(0, 5, "size=") == 0)
+            mapSize = atoi(option.c_str() + 5);
+        else if (option.compare(0, 7, "roster=") == 0)
+        {
+            istringstream counts(option.substr(7));
+            char comma;
+            counts >> roster.warriors >> comma >> roster.medics >> comma >> roster.supplies;
+        }
+    }
+
+    if (!logging)
+        Logger::setLevel(LOG_LEVEL_OFF);
+
+    TelemetrySink telemetry;
+    if (!eventsPath.empty() && !telemetry.open(eventsPath.c_str()))
+    {
+        cerr << "Cannot create " << eventsPath << endl;
+        return 1;
+    }
+
+    int wins[2] = { 0, 0 };
+    int draws = 0;
+    long long totalFrames = 0;
+
+    auto startTime = chrono::steady_clock::now();
+
+    ThreadPool pool(1); // Runs orange while the main thread runs blue
+    Simulation sim;
+    sim.setVisibilityEngine(fovEngine);
+    if (parallel)
+        sim.setParallel(&pool);
+    sim.setPathCache(pathCache);
+    sim.setDepotFields(depotFields);
+    sim.setMapSize(mapSize, mapSize);
+    sim.setRoster(roster);
+    if (telemetry.isOpen())
+        sim.setTelemetry(&telemetry);
+    for (int match = 0; match < matches; match++)
+    {
+        sim.reset(baseSeed + match);
+
+        while (sim.isRunning() && sim.getFrameCounter() < maxFrames)
+        {
+            if (fast)
+                sim.fastForward(maxFrames);
+            else
+                sim.step();
+        }
+
+        totalFrames += sim.getFrameCounter();
+
+        if (sim.isGameOver())
+            wins[sim.getWinningTeam()]++;
+        else
+            draws++;
+    }
+
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+
+    telemetry.close();
+
+    // Let the log writer catch up so the summary is not interleaved with unit logs
+    Logger::flush();
+
+    cout << "==================================" << endl;
+    cout << "   HEADLESS SIMULATION RESULTS" << endl;
+    cout << "==================================" << endl;
+    cout << "Matches:      " << matches << endl;
+    cout << "Seed:         " << baseSeed << endl;
+    cout << "Map size:     " << sim.getRows() << "x" << sim.getCols() << endl;
+    cout << "Roster:       1 commander, " << roster.warriors << " warriors, " << roster.medics
+        << " medics, " << roster.supplies << " supply" << endl;
+    cout << "Visibility:   " << (fovEngine == FOV_SHADOWCAST ? "shadowcast" : "bresenham") << endl;
+    cout << "Blue wins:    " << wins[TEAM_BLUE] << endl;
+    cout << "Orange wins:  " << wins[TEAM_ORANGE] << endl;
+    cout << "Draws:        " << draws << " (hit " << maxFrames << " frame limit)" << endl;
+    cout << "Total frames: " << totalFrames << endl;
+    cout << "Wall time:    " << seconds << " s" << endl;
+    if (seconds > 0)
+        cout << "Frames/sec:   " << (long long)(totalFrames / seconds) << endl;
+    cout << "==================================" << endl;
+
+    return 0;
+}
@@ -0,0 +1,162 @@
+#include <stdlib.h>
+#include <time.h>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <string>
+#include <sstream>
+#include <vector>
+
+#include "Definitions.h"
+#include "Simulation.h"
+#include "ThreadPool.h"
+#include "Log.h"
+
+using namespace std;
+
+/**
+ * Result of one tournament match
+ */
+struct MatchResult
+{
+    int winner;  // TEAM_BLUE, TEAM_ORANGE or NO_TEAM for a draw
+    int frames;  // Match length
+};
+
+/**
+ * Tournament runner - plays many seeded matches on all cores
+ * Usage: tournament [matches] [maxFrames] [threads] [seed=<n>] [size=<n>] [roster=<w>,<m>,<s>] [bresenham|shadowcast] [fast] [pathcache] [depotfields]
+ * Every worker thread owns one Simulation (map, units, generator) and reuses it for the matches it
+ * runs. Match i always uses seed n + i, so results do not depend on the thread count
+ * fast skips the frames in which no unit acts - the results are the same
+ * pathcache reuses A* paths while the safety maps are unchanged (different, still seeded, matches)
+ * depotfields walks support units to their depots down precomputed distance fields (different matches)
+ */
+int main(int argc, char* argv[])
+{
+    int matches = (argc > 1) ? atoi(argv[1]) : 1000;
+    int maxFrames = (argc > 2) ? atoi(argv[2]) : 20000;
+    int threads = (argc > 3) ? atoi(argv[3]) : 0;
+    uint64_t baseSeed = (uint64_t)time(0);
+    int fovEngine = FOV_BRESENHAM;
+    bool fast = false;
+    bool pathCache = false;
+    bool depotFields = false;
+    int mapSize = MAP_SIZE;
+    Roster roster = { DEFAULT_WARRIORS, DEFAULT_MEDICS, DEFAULT_SUPPLIES };
+
+    for (int i = 4; i < argc; i++)
+    {
+        string option = argv[i];
+        if (option.compare(0, 5, "seed=") == 0)
+            baseSeed = strtoull(option.c_str() + 5, nullptr, 10);
+        else if (option.compare(0, 5, "size=") == 0)
+            mapSize = atoi(option.c_str() + 5);
+        else if (option.compare(0, 7, "roster=") == 0)
+        {
+            istringstream counts(option.substr(7));
+            char comma;
+            counts >> roster.warriors >> comma >> roster.medics >> comma >> roster.supplies;
+        }
+        else if (option == "shadowcast")
+            fovEngine = FOV_SHADOWCAST;
+        else if (option == "fast")
+            fast = true;
+        else if (option == "pathcache")
+            pathCache = true;
+        else if (option == "depotfields")
+            depotFields = true;
+    }
+
+    Logger::setLevel(LOG_LEVEL_OFF);
+
+    ThreadPool pool(threads);
+    vector<unique_ptr<Simulation>> simulations(pool.size());
+    vector<MatchResult> results(matches);
+
+    auto startTime = chrono::steady_clock::now();
+
+    for (int match = 0; match < matches; match++)
+    {
+        pool.submit([&, match]()
+        {
+            unique_ptr<Simulation>& sim = simulations[ThreadPool::currentWorker()];
+            if (!sim)
+            {
+                sim.reset(new Simulation());
+                sim->setVisibilityEngine(fovEngine);
+                sim->setMapSize(mapSize, mapSize);
+                sim->setRoster(roster);
+                sim->setPathCache(pathCache);
+                sim->setDepotFields(depotFields);
+            }
+
+            sim->reset(baseSeed + match);
+            while (sim->isRunning() && sim->getFrameCounter() < maxFrames)
+            {
+                if (fast)
+                    sim->fastForward(maxFrames);
+                else
+                    sim->step();
+            }
+
+            results[match].winner = sim->isGameOver() ? sim->getWinningTeam() : NO_TEAM;
+            results[match].frames = sim->getFrameCounter();
+        });
+    }
+
+    pool.waitAll();
+
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+
+    int wins[2] = { 0, 0 };
+    int draws = 0;
+    long long totalFrames = 0;
+    long long decidedFrames = 0;
+
+    for (const MatchResult& result : results)
+    {
+        totalFrames += result.frames;
+        if (result.winner == NO_TEAM)
+        {
+            draws++;
+        }
+        else
+        {
+            wins[result.winner]++;
+            decidedFrames += result.frames;
+        }
+    }
+
+    int decided = wins[TEAM_BLUE] + wins[TEAM_ORANGE];
+
+    cout << fixed << setprecision(1);
+    cout << "==================================" << endl;
+    cout << "   TOURNAMENT RESULTS" << endl;
+    cout << "==================================" << endl;
+    cout << "Matches:          " << matches << " (" << pool.size() << " threads)" << endl;
+    cout << "Seed:             " << baseSeed << endl;
+    cout << "Map size:         " << mapSize << "x" << mapSize << endl;
+    cout << "Roster:           1 commander, " << roster.warriors << " warriors, " << roster.medics
+        << " medics, " << roster.supplies << " supply" << endl;
+    cout << "Visibility:       " << (fovEngine == FOV_SHADOWCAST ? "shadowcast" : "bresenham") << endl;
+    if (matches > 0)
+    {
+        cout << "Blue win rate:    " << 100.0 * wins[TEAM_BLUE] / matches << "% (" << wins[TEAM_BLUE] << ")" << endl;
+        cout << "Orange win rate:  " << 100.0 * wins[TEAM_ORANGE] / matches << "% (" << wins[TEAM_ORANGE] << ")" << endl;
+        cout << "Draws:            " << 100.0 * draws / matches << "% (" << draws << ", hit " << maxFrames << " frames)" << endl;
+        cout << "Mean length:      " << (double)totalFrames / matches << " frames" << endl;
+    }
+    if (decided > 0)
+        cout << "Mean decided:     " << (double)decidedFrames / decided << " frames" << endl;
+    cout << "Wall time:        " << setprecision(3) << seconds << " s" << endl;
+    if (seconds > 0)
+    {
+        cout << "Matches/sec:      " << setprecision(1) << matches / seconds << endl;
+        cout << "Frames/sec:       " << (long long)(totalFrames / seconds) << endl;
+    }
+    cout << "==================================" << endl;
+
+    return 0;
+}